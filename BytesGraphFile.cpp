@@ -0,0 +1,451 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#include "Pathfinding/BytesGraphFile.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+
+namespace
+{
+	uint64 AlignSection(const uint64 Offset)
+	{
+		return (Offset + BytesGraphFile::SectionAlignment - 1) & ~uint64(BytesGraphFile::SectionAlignment - 1);
+	}
+
+	bool WritePadding(IFileHandle& FileHandle, const uint64 From, const uint64 To)
+	{
+		static const uint8 Zeros[BytesGraphFile::SectionAlignment] = {};
+		return To <= From || FileHandle.Write(Zeros, To - From);
+	}
+
+	// Flattens Adjacency Lists into CSR, returns the Number of Edges.
+	// Edges into removed Nodes are dropped, removed Nodes end up isolated.
+	int32 FlattenEdges(const FBytesGraph& Graph, const TArray<FBytesEdges>& Edges, TArray<int32>& OutOffsets, TArray<int32>& OutTargets, TArray<int32>& OutWeights)
+	{
+		const int32 NumNodes = Edges.Num();
+		OutOffsets.SetNumUninitialized(NumNodes + 1);
+		OutTargets.Reset();
+		OutWeights.Reset();
+
+		for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+		{
+			OutOffsets[NodeID] = OutTargets.Num();
+			for (const FBytesEdge& Edge : Edges[NodeID].NeighbouringEdges)
+			{
+				if (!Graph.Nodes[Edge.NodeID].bRemoved)
+				{
+					OutTargets.Add(Edge.NodeID);
+					OutWeights.Add(Edge.Weight);
+				}
+			}
+		}
+		OutOffsets[NumNodes] = OutTargets.Num();
+
+		return OutTargets.Num();
+	}
+
+	/*
+	 * Mapped CSR has to start at 0, never run backwards, end at the Edge Count, only point at existing Nodes and never cost less than 0.
+	 * Both Ends of every Edge have to share their Component Label, otherwise the Labels are dropped and get rebuilt after Loading
+	 */
+	bool AreEdgesValid(const int32* Offsets, const int32* Targets, const int32* Weights, const int32 NumNodes, const int32 NumEdges, const int32*& InOutComponents)
+	{
+		if (Offsets[0] != 0 || Offsets[NumNodes] != NumEdges)
+		{
+			return false;
+		}
+		for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+		{
+			if (Offsets[NodeID + 1] < Offsets[NodeID])
+			{
+				return false;
+			}
+		}
+		for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+		{
+			for (int32 EdgeIndex = Offsets[NodeID]; EdgeIndex < Offsets[NodeID + 1]; EdgeIndex++)
+			{
+				const int32 TargetID = Targets[EdgeIndex];
+				if (TargetID < 0 || TargetID >= NumNodes || Weights[EdgeIndex] < 0)
+				{
+					return false;
+				}
+				if (InOutComponents && InOutComponents[NodeID] != InOutComponents[TargetID])
+				{
+					InOutComponents = nullptr;
+				}
+			}
+		}
+		return true;
+	}
+}
+
+bool BytesGraphFile::Save(const FBytesGraph& Graph, const FString& FilePath)
+{
+#if !PLATFORM_LITTLE_ENDIAN
+	UE_LOG(LogTemp, Warning, TEXT("Graph File: Saving is only supported on Little Endian Platforms"));
+	return false;
+#else
+	const int32 NumNodes = Graph.Nodes.Num();
+
+	// ==== Sub Section | Flatten Adjacency Lists into CSR ==== //
+
+	TArray<int32> Offsets;
+	TArray<int32> Targets;
+	TArray<int32> Weights;
+	const int32 NumEdges = FlattenEdges(Graph, Graph.Edges, Offsets, Targets, Weights);
+
+	TArray<int32> ReverseOffsets;
+	TArray<int32> ReverseTargets;
+	TArray<int32> ReverseWeights;
+	if (Graph.bDirected)
+	{
+		FlattenEdges(Graph, Graph.ReverseEdges, ReverseOffsets, ReverseTargets, ReverseWeights);
+	}
+
+	TArray<double> Locations;
+	Locations.SetNumUninitialized(NumNodes * 2);
+	for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+	{
+		Locations[NodeID * 2] = Graph.Nodes[NodeID].Location2D.X;
+		Locations[NodeID * 2 + 1] = Graph.Nodes[NodeID].Location2D.Y;
+	}
+
+	// Components are only written if they are up to Date, Readers rebuild them otherwise
+	TArray<int32> Components;
+	if (!Graph.Components.NeedsRebuild(NumNodes))
+	{
+		Components.SetNumUninitialized(NumNodes);
+		for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+		{
+			Components[NodeID] = Graph.Components.FindRoot(NodeID);
+		}
+	}
+
+	TArray<uint8> TerrainClasses;
+	if (Graph.NumTerrainClasses > 1)
+	{
+		TerrainClasses.SetNumUninitialized(NumNodes);
+		for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+		{
+			TerrainClasses[NodeID] = Graph.Nodes[NodeID].TerrainClass;
+		}
+	}
+
+	// ==== Sub Section | Layout ==== //
+
+	struct FPendingSection
+	{
+		FBytesGraphFileSection Section;
+		const void* Source;
+	};
+
+	TArray<FPendingSection> PendingSections;
+	PendingSections.Add({{TagOffsets, sizeof(int32), 0, uint64(Offsets.Num())}, Offsets.GetData()});
+	PendingSections.Add({{TagTargets, sizeof(int32), 0, uint64(Targets.Num())}, Targets.GetData()});
+	PendingSections.Add({{TagWeights, sizeof(int32), 0, uint64(Weights.Num())}, Weights.GetData()});
+	PendingSections.Add({{TagLocations, sizeof(double), 0, uint64(Locations.Num())}, Locations.GetData()});
+	PendingSections.Add({{TagHeuristicScale, sizeof(double), 0, 1}, &Graph.HeuristicScale});
+	if (!Components.IsEmpty())
+	{
+		PendingSections.Add({{TagComponents, sizeof(int32), 0, uint64(Components.Num())}, Components.GetData()});
+	}
+	if (!TerrainClasses.IsEmpty())
+	{
+		PendingSections.Add({{TagTerrainClasses, sizeof(uint8), 0, uint64(TerrainClasses.Num())}, TerrainClasses.GetData()});
+	}
+	if (Graph.bDirected)
+	{
+		PendingSections.Add({{TagReverseOffsets, sizeof(int32), 0, uint64(ReverseOffsets.Num())}, ReverseOffsets.GetData()});
+		PendingSections.Add({{TagReverseTargets, sizeof(int32), 0, uint64(ReverseTargets.Num())}, ReverseTargets.GetData()});
+		PendingSections.Add({{TagReverseWeights, sizeof(int32), 0, uint64(ReverseWeights.Num())}, ReverseWeights.GetData()});
+	}
+
+	uint64 FileOffset = AlignSection(sizeof(FBytesGraphFileHeader) + sizeof(FBytesGraphFileSection) * PendingSections.Num());
+	for (FPendingSection& Pending : PendingSections)
+	{
+		Pending.Section.Offset = FileOffset;
+		FileOffset = AlignSection(FileOffset + Pending.Section.ElementSize * Pending.Section.Count);
+	}
+
+	FBytesGraphFileHeader Header;
+	FMemory::Memzero(&Header, sizeof(Header));
+	Header.Magic = Magic;
+	Header.Version = Version;
+	Header.GraphType = static_cast<uint8>(Graph.GraphType);
+	Header.Flags = Graph.bDirected ? FlagDirected : 0;
+	Header.HeaderSize = sizeof(FBytesGraphFileHeader);
+	Header.SectionCount = PendingSections.Num();
+	Header.NumNodes = NumNodes;
+	Header.NumEdges = NumEdges;
+	Header.FileSize = FileOffset;
+
+	// ==== Sub Section | Write ==== //
+
+	const TUniquePtr<IFileHandle> FileHandle(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*FilePath));
+	if (!FileHandle)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Graph File: Could not open %s for Writing"), *FilePath);
+		return false;
+	}
+
+	bool bSuccess = FileHandle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+	for (const FPendingSection& Pending : PendingSections)
+	{
+		bSuccess &= FileHandle->Write(reinterpret_cast<const uint8*>(&Pending.Section), sizeof(FBytesGraphFileSection));
+	}
+
+	uint64 WrittenBytes = sizeof(FBytesGraphFileHeader) + sizeof(FBytesGraphFileSection) * PendingSections.Num();
+	for (const FPendingSection& Pending : PendingSections)
+	{
+		bSuccess &= WritePadding(*FileHandle, WrittenBytes, Pending.Section.Offset);
+
+		const uint64 SectionSize = Pending.Section.ElementSize * Pending.Section.Count;
+		bSuccess &= FileHandle->Write(static_cast<const uint8*>(Pending.Source), SectionSize);
+		WrittenBytes = Pending.Section.Offset + SectionSize;
+	}
+	bSuccess &= WritePadding(*FileHandle, WrittenBytes, Header.FileSize);
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Graph File: Writing %s failed"), *FilePath);
+	}
+	return bSuccess;
+#endif
+}
+
+TUniquePtr<FBytesMappedGraph> FBytesMappedGraph::Open(const FString& FilePath)
+{
+#if !PLATFORM_LITTLE_ENDIAN
+	UE_LOG(LogTemp, Warning, TEXT("Graph File: Mapping is only supported on Little Endian Platforms"));
+	return nullptr;
+#else
+	TUniquePtr<FBytesMappedGraph> MappedGraph(new FBytesMappedGraph());
+
+	MappedGraph->FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+	if (!MappedGraph->FileHandle)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Graph File: Could not map %s"), *FilePath);
+		return nullptr;
+	}
+
+	const int64 FileSize = MappedGraph->FileHandle->GetFileSize();
+	if (FileSize < int64(sizeof(FBytesGraphFileHeader)))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Graph File: %s is too small"), *FilePath);
+		return nullptr;
+	}
+
+	MappedGraph->FileRegion.Reset(MappedGraph->FileHandle->MapRegion(0, FileSize));
+	if (!MappedGraph->FileRegion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Graph File: Could not map Region of %s"), *FilePath);
+		return nullptr;
+	}
+
+	// ==== Sub Section | Validate Header ==== //
+
+	const uint8* Data = MappedGraph->FileRegion->GetMappedPtr();
+	const FBytesGraphFileHeader* Header = reinterpret_cast<const FBytesGraphFileHeader*>(Data);
+
+	if (Header->Magic != BytesGraphFile::Magic || Header->Version != BytesGraphFile::Version || Header->FileSize != uint64(FileSize))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Graph File: %s is not a valid Graph File of Version %d"), *FilePath, BytesGraphFile::Version);
+		return nullptr;
+	}
+
+	const uint64 SectionTableEnd = uint64(Header->HeaderSize) + uint64(Header->SectionCount) * sizeof(FBytesGraphFileSection);
+	if (Header->HeaderSize < sizeof(FBytesGraphFileHeader) || Header->HeaderSize % alignof(FBytesGraphFileSection) != 0 || SectionTableEnd > uint64(FileSize)
+		|| Header->NumNodes < 0 || Header->NumEdges < 0 || Header->GraphType > uint8(EBytesGraphType::Hexagonal))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Graph File: %s has a broken Header"), *FilePath);
+		return nullptr;
+	}
+
+	MappedGraph->Data = Data;
+	MappedGraph->Sections = reinterpret_cast<const FBytesGraphFileSection*>(Data + Header->HeaderSize);
+	MappedGraph->SectionCount = Header->SectionCount;
+	MappedGraph->NodeCount = Header->NumNodes;
+	MappedGraph->EdgeCount = Header->NumEdges;
+	MappedGraph->GraphType = static_cast<EBytesGraphType>(Header->GraphType);
+
+	// ==== Sub Section | Validate Sections ==== //
+
+	// Compared by Division, Offset + Size could overflow
+	for (uint32 SectionIndex = 0; SectionIndex < MappedGraph->SectionCount; SectionIndex++)
+	{
+		const FBytesGraphFileSection& Section = MappedGraph->Sections[SectionIndex];
+		if (Section.Offset % BytesGraphFile::SectionAlignment != 0 || Section.Offset > uint64(FileSize)
+			|| (Section.ElementSize != 0 && Section.Count > (uint64(FileSize) - Section.Offset) / Section.ElementSize))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Graph File: %s has a broken Section Table"), *FilePath);
+			return nullptr;
+		}
+	}
+
+	const uint64 NumNodes = MappedGraph->NodeCount;
+	const uint64 NumEdges = MappedGraph->EdgeCount;
+	uint64 Count = 0;
+
+	MappedGraph->Offsets = reinterpret_cast<const int32*>(MappedGraph->FindSection(BytesGraphFile::TagOffsets, sizeof(int32), Count));
+	const bool bOffsetsValid = MappedGraph->Offsets && Count == NumNodes + 1;
+
+	MappedGraph->Targets = reinterpret_cast<const int32*>(MappedGraph->FindSection(BytesGraphFile::TagTargets, sizeof(int32), Count));
+	const bool bTargetsValid = MappedGraph->Targets && Count == NumEdges;
+
+	MappedGraph->Weights = reinterpret_cast<const int32*>(MappedGraph->FindSection(BytesGraphFile::TagWeights, sizeof(int32), Count));
+	const bool bWeightsValid = MappedGraph->Weights && Count == NumEdges;
+
+	MappedGraph->Locations = reinterpret_cast<const double*>(MappedGraph->FindSection(BytesGraphFile::TagLocations, sizeof(double), Count));
+	const bool bLocationsValid = MappedGraph->Locations && Count == NumNodes * 2;
+
+	if (!bOffsetsValid || !bTargetsValid || !bWeightsValid || !bLocationsValid)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Graph File: %s is missing required Sections"), *FilePath);
+		return nullptr;
+	}
+
+	// Every Label has to be a Root and match along every Edge below, otherwise the Section is ignored
+	const int32* Components = reinterpret_cast<const int32*>(MappedGraph->FindSection(BytesGraphFile::TagComponents, sizeof(int32), Count));
+	if (Components && Count == NumNodes)
+	{
+		bool bComponentsValid = true;
+		for (uint64 NodeID = 0; NodeID < NumNodes && bComponentsValid; NodeID++)
+		{
+			bComponentsValid = Components[NodeID] >= 0 && uint64(Components[NodeID]) < NumNodes && Components[Components[NodeID]] == Components[NodeID];
+		}
+		MappedGraph->Components = bComponentsValid ? Components : nullptr;
+	}
+
+	// Searches index the mapped Arrays without any Checks
+	if (!AreEdgesValid(MappedGraph->Offsets, MappedGraph->Targets, MappedGraph->Weights, MappedGraph->NodeCount, MappedGraph->EdgeCount, MappedGraph->Components))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Graph File: %s has broken Edges"), *FilePath);
+		return nullptr;
+	}
+
+	// A Scale above 1, below 0 or NaN would let the Heuristic overestimate, so A* would return wrong Paths
+	const double* HeuristicScale = reinterpret_cast<const double*>(MappedGraph->FindSection(BytesGraphFile::TagHeuristicScale, sizeof(double), Count));
+	if (HeuristicScale && Count == 1)
+	{
+		if (!(*HeuristicScale >= 0.0 && *HeuristicScale <= 1.0))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Graph File: %s has an invalid Heuristic Scale"), *FilePath);
+			return nullptr;
+		}
+		MappedGraph->HeuristicScale = *HeuristicScale;
+	}
+
+	const uint8* TerrainClasses = MappedGraph->FindSection(BytesGraphFile::TagTerrainClasses, sizeof(uint8), Count);
+	if (TerrainClasses && Count == NumNodes)
+	{
+		MappedGraph->TerrainClasses = TerrainClasses;
+		for (uint64 NodeID = 0; NodeID < NumNodes; NodeID++)
+		{
+			MappedGraph->NumTerrainClasses = FMath::Max(MappedGraph->NumTerrainClasses, TerrainClasses[NodeID] + 1);
+		}
+	}
+
+	if (Header->Flags & BytesGraphFile::FlagDirected)
+	{
+		MappedGraph->ReverseOffsets = reinterpret_cast<const int32*>(MappedGraph->FindSection(BytesGraphFile::TagReverseOffsets, sizeof(int32), Count));
+		const bool bReverseOffsetsValid = MappedGraph->ReverseOffsets && Count == NumNodes + 1;
+
+		MappedGraph->ReverseTargets = reinterpret_cast<const int32*>(MappedGraph->FindSection(BytesGraphFile::TagReverseTargets, sizeof(int32), Count));
+		const bool bReverseTargetsValid = MappedGraph->ReverseTargets && Count == NumEdges;
+
+		MappedGraph->ReverseWeights = reinterpret_cast<const int32*>(MappedGraph->FindSection(BytesGraphFile::TagReverseWeights, sizeof(int32), Count));
+		const bool bReverseWeightsValid = MappedGraph->ReverseWeights && Count == NumEdges;
+
+		if (!bReverseOffsetsValid || !bReverseTargetsValid || !bReverseWeightsValid
+			|| !AreEdgesValid(MappedGraph->ReverseOffsets, MappedGraph->ReverseTargets, MappedGraph->ReverseWeights, MappedGraph->NodeCount, MappedGraph->EdgeCount, MappedGraph->Components))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Graph File: %s is directed but has no valid Reverse Edges"), *FilePath);
+			return nullptr;
+		}
+	}
+
+	return MappedGraph;
+#endif
+}
+
+FBytesMappedGraph::~FBytesMappedGraph()
+{
+	// The Region has to be unmapped before its File Handle gets closed
+	FileRegion.Reset();
+	FileHandle.Reset();
+}
+
+const uint8* FBytesMappedGraph::FindSection(const uint32 Tag, const uint32 ElementSize, uint64& OutCount) const
+{
+	for (uint32 SectionIndex = 0; SectionIndex < SectionCount; SectionIndex++)
+	{
+		if (Sections[SectionIndex].Tag == Tag && Sections[SectionIndex].ElementSize == ElementSize)
+		{
+			OutCount = Sections[SectionIndex].Count;
+			return Data + Sections[SectionIndex].Offset;
+		}
+	}
+
+	OutCount = 0;
+	return nullptr;
+}
+
+void FBytesMappedGraph::CopyToGraph(FBytesGraph& OutGraph) const
+{
+	OutGraph = FBytesGraph();
+	OutGraph.GraphType = GraphType;
+	OutGraph.HeuristicScale = HeuristicScale;
+	OutGraph.NumTerrainClasses = NumTerrainClasses;
+
+	// Labels become a flat Union Find: every Node points at its Root, Roots store the negative Size
+	if (Components)
+	{
+		TArray<int32>& Parent = OutGraph.Components.Parent;
+		Parent.Init(0, NodeCount);
+		for (int32 NodeID = 0; NodeID < NodeCount; NodeID++)
+		{
+			Parent[Components[NodeID]]--;
+		}
+		for (int32 NodeID = 0; NodeID < NodeCount; NodeID++)
+		{
+			if (Components[NodeID] != NodeID)
+			{
+				Parent[NodeID] = Components[NodeID];
+			}
+		}
+	}
+	OutGraph.Nodes.SetNum(NodeCount);
+	OutGraph.Edges.SetNum(NodeCount);
+	OutGraph.bDirected = IsDirected();
+	if (OutGraph.bDirected)
+	{
+		OutGraph.ReverseEdges.SetNum(NodeCount);
+	}
+
+	for (int32 NodeID = 0; NodeID < NodeCount; NodeID++)
+	{
+		OutGraph.Nodes[NodeID].Location2D = GetLocation(NodeID);
+		OutGraph.Nodes[NodeID].TerrainClass = GetTerrainClass(NodeID);
+
+		TArray<FBytesEdge>& NeighbouringEdges = OutGraph.Edges[NodeID].NeighbouringEdges;
+		NeighbouringEdges.Reserve(Offsets[NodeID + 1] - Offsets[NodeID]);
+		ForEachNeighbour(NodeID, [&NeighbouringEdges](const int32 NeighbourID, const int32 Weight)
+		{
+			FBytesEdge& Edge = NeighbouringEdges.AddDefaulted_GetRef();
+			Edge.NodeID = NeighbourID;
+			Edge.Weight = Weight;
+		});
+
+		if (OutGraph.bDirected)
+		{
+			TArray<FBytesEdge>& IncomingEdges = OutGraph.ReverseEdges[NodeID].NeighbouringEdges;
+			IncomingEdges.Reserve(ReverseOffsets[NodeID + 1] - ReverseOffsets[NodeID]);
+			ForEachIncomingNeighbour(NodeID, [&IncomingEdges](const int32 SourceID, const int32 Weight)
+			{
+				FBytesEdge& Edge = IncomingEdges.AddDefaulted_GetRef();
+				Edge.NodeID = SourceID;
+				Edge.Weight = Weight;
+			});
+		}
+	}
+}
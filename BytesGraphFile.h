@@ -0,0 +1,216 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Pathfinding/BytesPathfinder.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/*
+ * Binary Graph File Format, Version 1
+ *
+ * Everything is stored Little Endian and every Section starts 16 Byte aligned,
+ * so a mapped File can be read in place without any Parsing.
+ *
+ * [Header]            FBytesGraphFileHeader
+ * [Section Table]     FBytesGraphFileSection * SectionCount
+ * [Sections]          Compressed Sparse Row Graph + optional precomputed Data
+ *
+ * Required Sections:
+ * OFFS  int32[NumNodes + 1]   First Edge of each Node, Edges of Node N are [OFFS[N], OFFS[N + 1])
+ * TGTS  int32[NumEdges]       Neighbour Node ID of each Edge
+ * WGTS  int32[NumEdges]       Weight of each Edge
+ * LOCS  double[NumNodes * 2]  Location2D X, Y of each Node
+ *
+ * Optional Sections:
+ * HSCL  double[1]             Heuristic Scale, see "FBytesGraph::HeuristicScale". 1 if missing
+ * CMPT  int32[NumNodes]       Root Node ID of each Node's Component, see "FBytesComponents". Skipped if a Rebuild is pending
+ * TERR  uint8[NumNodes]       Terrain Class of each Node, see "FBytesCostProfile". Skipped if every Node has Class 0
+ *
+ * Directed Graphs (Header Flag "FlagDirected") also store the Incoming Edges in the same Layout:
+ * ROFS  int32[NumNodes + 1]
+ * RTGS  int32[NumEdges]       Source Node ID of each Incoming Edge
+ * RWGT  int32[NumEdges]
+ *
+ * Unknown Sections are skipped, so newer precomputed Data does not break older Readers.
+ * Files are not trusted: Section Bounds, Element Sizes, Offsets, Node IDs, Weights and the Heuristic Scale are all checked on Open,
+ * Component Labels that contradict an Edge are dropped.
+ */
+namespace BytesGraphFile
+{
+	constexpr uint32 MakeTag(const char A, const char B, const char C, const char D)
+	{
+		return uint32(uint8(A)) | uint32(uint8(B)) << 8 | uint32(uint8(C)) << 16 | uint32(uint8(D)) << 24;
+	}
+
+	constexpr uint32 Magic = MakeTag('B', 'P', 'G', 'F');
+	constexpr uint16 Version = 1;
+	constexpr uint32 SectionAlignment = 16;
+
+	constexpr uint32 TagOffsets = MakeTag('O', 'F', 'F', 'S');
+	constexpr uint32 TagTargets = MakeTag('T', 'G', 'T', 'S');
+	constexpr uint32 TagWeights = MakeTag('W', 'G', 'T', 'S');
+	constexpr uint32 TagLocations = MakeTag('L', 'O', 'C', 'S');
+	constexpr uint32 TagHeuristicScale = MakeTag('H', 'S', 'C', 'L');
+	constexpr uint32 TagComponents = MakeTag('C', 'M', 'P', 'T');
+	constexpr uint32 TagTerrainClasses = MakeTag('T', 'E', 'R', 'R');
+	constexpr uint32 TagReverseOffsets = MakeTag('R', 'O', 'F', 'S');
+	constexpr uint32 TagReverseTargets = MakeTag('R', 'T', 'G', 'S');
+	constexpr uint32 TagReverseWeights = MakeTag('R', 'W', 'G', 'T');
+
+	constexpr uint8 FlagDirected = 1 << 0;
+
+	// Writes the Graph as a baked File. Returns false if the File could not be written.
+	// Removed Nodes are written as isolated Nodes, compact the Graph first to drop them.
+	BYTESHEXGRIDPLUGIN_API bool Save(const FBytesGraph& Graph, const FString& FilePath);
+}
+
+struct FBytesGraphFileHeader
+{
+	uint32 Magic;
+	uint16 Version;
+	uint8 GraphType;
+	uint8 Flags;
+	uint32 HeaderSize;
+	uint32 SectionCount;
+	int32 NumNodes;
+	int32 NumEdges;
+	uint64 FileSize;
+};
+static_assert(sizeof(FBytesGraphFileHeader) == 32, "Graph File Header Layout must not change");
+
+struct FBytesGraphFileSection
+{
+	uint32 Tag;
+	uint32 ElementSize;
+	uint64 Offset;
+	uint64 Count;
+};
+static_assert(sizeof(FBytesGraphFileSection) == 24, "Graph File Section Layout must not change");
+
+/*
+ * A read only Graph living inside a memory mapped Graph File.
+ * Works as Graph Accessor for the Search Templates in "BytesPathfinderSearch.h",
+ * Searches read the mapped Pages directly.
+ */
+class BYTESHEXGRIDPLUGIN_API FBytesMappedGraph
+{
+public:
+	// Maps the File and validates Header, Sections and Edges. Returns nullptr if the File is missing or invalid.
+	static TUniquePtr<FBytesMappedGraph> Open(const FString& FilePath);
+
+	~FBytesMappedGraph();
+
+	int32 NumNodes() const
+	{
+		return NodeCount;
+	}
+
+	int32 NumEdges() const
+	{
+		return EdgeCount;
+	}
+
+	EBytesGraphType GetGraphType() const
+	{
+		return GraphType;
+	}
+
+	FVector2D GetLocation(const int32 NodeID) const
+	{
+		return FVector2D(Locations[NodeID * 2], Locations[NodeID * 2 + 1]);
+	}
+
+	double GetHeuristicScale() const
+	{
+		return HeuristicScale;
+	}
+
+	uint8 GetTerrainClass(const int32 NodeID) const
+	{
+		return TerrainClasses ? TerrainClasses[NodeID] : 0;
+	}
+
+	int32 GetNumTerrainClasses() const
+	{
+		return NumTerrainClasses;
+	}
+
+	bool IsDirected() const
+	{
+		return ReverseOffsets != nullptr;
+	}
+
+	// False if no Path between both Nodes can exist. Always true for Files without Component Section
+	bool AreNodesConnected(const int32 NodeAID, const int32 NodeBID) const
+	{
+		return !Components || Components[NodeAID] == Components[NodeBID];
+	}
+
+	template<typename FunctorType>
+	void ForEachNeighbour(const int32 NodeID, FunctorType&& Functor) const
+	{
+		const int32 End = Offsets[NodeID + 1];
+		for (int32 EdgeIndex = Offsets[NodeID]; EdgeIndex < End; EdgeIndex++)
+		{
+			Functor(Targets[EdgeIndex], Weights[EdgeIndex]);
+		}
+	}
+
+	// Undirected Graphs are their own Reverse
+	template<typename FunctorType>
+	void ForEachIncomingNeighbour(const int32 NodeID, FunctorType&& Functor) const
+	{
+		if (!IsDirected())
+		{
+			ForEachNeighbour(NodeID, Forward<FunctorType>(Functor));
+			return;
+		}
+
+		const int32 End = ReverseOffsets[NodeID + 1];
+		for (int32 EdgeIndex = ReverseOffsets[NodeID]; EdgeIndex < End; EdgeIndex++)
+		{
+			Functor(ReverseTargets[EdgeIndex], ReverseWeights[EdgeIndex]);
+		}
+	}
+
+	// Returns the raw Section Data or nullptr if it is missing or stores Elements of another Size, used for optional precomputed Sections
+	const uint8* FindSection(const uint32 Tag, const uint32 ElementSize, uint64& OutCount) const;
+
+	// Copies the mapped Data into an editable Graph
+	void CopyToGraph(FBytesGraph& OutGraph) const;
+
+private:
+	FBytesMappedGraph() = default;
+
+	TUniquePtr<IMappedFileHandle> FileHandle;
+	TUniquePtr<IMappedFileRegion> FileRegion;
+
+	const uint8* Data = nullptr;
+	const FBytesGraphFileSection* Sections = nullptr;
+	uint32 SectionCount = 0;
+
+	int32 NodeCount = 0;
+	int32 EdgeCount = 0;
+	EBytesGraphType GraphType = EBytesGraphType::Distance2D;
+	double HeuristicScale = 1.0;
+
+	const int32* Offsets = nullptr;
+	const int32* Targets = nullptr;
+	const int32* Weights = nullptr;
+	const double* Locations = nullptr;
+
+	// Optional, nullptr if the File has no Component Section or its Labels contradict an Edge
+	const int32* Components = nullptr;
+
+	// Optional, nullptr if every Node has Terrain Class 0
+	const uint8* TerrainClasses = nullptr;
+	int32 NumTerrainClasses = 1;
+
+	// Only set for directed Graphs
+	const int32* ReverseOffsets = nullptr;
+	const int32* ReverseTargets = nullptr;
+	const int32* ReverseWeights = nullptr;
+};
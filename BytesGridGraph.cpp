@@ -0,0 +1,694 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#include "Pathfinding/BytesGridGraph.h"
+
+#if BYTES_GRID_SIMD && PLATFORM_ALWAYS_HAS_AVX_2
+	#define BYTES_GRID_AVX2 1
+	#include <immintrin.h>
+#elif BYTES_GRID_SIMD && PLATFORM_ALWAYS_HAS_SSE4_1
+	#define BYTES_GRID_SSE4 1
+	#include <smmintrin.h>
+#endif
+
+#ifndef BYTES_GRID_AVX2
+	#define BYTES_GRID_AVX2 0
+#endif
+#ifndef BYTES_GRID_SSE4
+	#define BYTES_GRID_SSE4 0
+#endif
+
+namespace
+{
+	// Padding behind the last Cell, see "FBytesGridGraph::Costs"
+	constexpr int32 CostPadding = 3;
+
+	// Diagonal Lane 4 + I is only allowed if both of its Sides are passable, see "BytesGrid::DiagonalSides"
+	uint32 DropCornerCuts(const uint32 PassableLanes)
+	{
+		const uint32 Horizontal = PassableLanes & 3;
+		const uint32 AllowedLanes = 0xF | (PassableLanes >> 2 & 1 ? Horizontal << 4 : 0) | (PassableLanes >> 3 & 1 ? Horizontal << 6 : 0);
+		return PassableLanes & AllowedLanes;
+	}
+
+	// Hex Grids compare Axial Coordinates, see https://www.redblobgames.com/grids/hexagons/
+	int32 GetAxialColumn(const int32 X, const int32 Y)
+	{
+		return X - (Y - (Y & 1)) / 2;
+	}
+
+	// ==== Sub Section | Bit Lines ==== //
+	// One Row or Column of the Walkable Bits, Position P is Bit P % 64 of Word P / 64
+
+	// Every Cell of the Line walkable, Bits behind Length stay 0
+	void FillBitLine(uint64* Words, const int32 Length)
+	{
+		for (int32 Position = 0; Position < Length; Position += 64)
+		{
+			const int32 NumBits = FMath::Min(Length - Position, 64);
+			Words[Position >> 6] = NumBits == 64 ? ~uint64(0) : (uint64(1) << NumBits) - 1;
+		}
+	}
+
+	void SetBit(uint64* Words, const int32 Position, const bool bValue)
+	{
+		const uint64 Mask = uint64(1) << (Position & 63);
+		Words[Position >> 6] = bValue ? Words[Position >> 6] | Mask : Words[Position >> 6] & ~Mask;
+	}
+
+	// Set Bits after Position in Step Direction before the first clear Bit
+	int32 ScanBitLine(const uint64* Words, const int32 Position, const int32 Step, const int32 Length)
+	{
+		int32 Count = 0;
+		if (Step > 0)
+		{
+			for (int32 Next = Position + 1; Next < Length;)
+			{
+				// Bits from Next upwards, the Bits shifted in on Top do not belong to the Line
+				const int32 Offset = Next & 63;
+				const uint64 Available = Offset == 0 ? ~uint64(0) : ~uint64(0) >> Offset;
+				const uint64 Blocked = ~(Words[Next >> 6] >> Offset) & Available;
+				if (Blocked != 0)
+				{
+					return Count + int32(FMath::CountTrailingZeros64(Blocked));
+				}
+				Count += 64 - Offset;
+				Next += 64 - Offset;
+			}
+			return FMath::Min(Count, Length - Position - 1);
+		}
+
+		for (int32 Next = Position - 1; Next >= 0;)
+		{
+			// Bits from Next downwards, moved to the Top of the Word
+			const int32 Offset = Next & 63;
+			const uint64 Available = Offset == 63 ? ~uint64(0) : ~(~uint64(0) >> (Offset + 1));
+			const uint64 Blocked = ~(Words[Next >> 6] << (63 - Offset)) & Available;
+			if (Blocked != 0)
+			{
+				return Count + int32(FMath::CountLeadingZeros64(Blocked));
+			}
+			Count += Offset + 1;
+			Next -= Offset + 1;
+		}
+		return Count;
+	}
+
+	// Every Bit in [First, Last] set, a whole Word per Step
+	bool IsBitSpanSet(const uint64* Words, const int32 First, const int32 Last)
+	{
+		for (int32 WordIndex = First >> 6; WordIndex <= Last >> 6; WordIndex++)
+		{
+			const int32 Low = WordIndex == First >> 6 ? First & 63 : 0;
+			const int32 High = WordIndex == Last >> 6 ? Last & 63 : 63;
+			const uint64 Mask = (High == 63 ? ~uint64(0) : (uint64(1) << (High + 1)) - 1) & ~((uint64(1) << Low) - 1);
+			if ((Words[WordIndex] & Mask) != Mask)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	int64 FloorDivide(const int64 Numerator, const int64 Denominator)
+	{
+		return Numerator >= 0 ? Numerator / Denominator : -((-Numerator + Denominator - 1) / Denominator);
+	}
+
+	/*
+	 * Lines of Sight on Square Grids: Line V holds Positions U, e.g. Row Y holds Cells X. Walks the Lines
+	 * the Segment between both Cell Centers crosses and calls Functor(V, First, Last) with the Span of Cells it touches,
+	 * Borders and Corners included. Stops once the Functor returns false.
+	 * Coordinates are in half Cells, so Cell Centers are odd and Cell Borders even.
+	 */
+	template<typename FunctorType>
+	bool ForEachSegmentSpan(int32 U0, int32 V0, int32 U1, int32 V1, const int32 LineLength, FunctorType&& Functor)
+	{
+		if (V0 > V1)
+		{
+			Swap(U0, U1);
+			Swap(V0, V1);
+		}
+
+		const int64 HalfU0 = 2 * int64(U0) + 1;
+		const int64 HalfV0 = 2 * int64(V0) + 1;
+		const int64 DeltaU = 2 * int64(U1) + 1 - HalfU0;
+		const int64 DeltaV = 2 * int64(V1) + 1 - HalfV0;
+
+		for (int32 V = V0; V <= V1; V++)
+		{
+			int64 First = FMath::Min(U0, U1);
+			int64 Last = FMath::Max(U0, U1);
+			if (DeltaV != 0)
+			{
+				// U where the Segment enters and leaves Line V, as Fractions over DeltaV
+				const int64 EnterV = FMath::Max<int64>(2 * V, HalfV0);
+				const int64 LeaveV = FMath::Min<int64>(2 * V + 2, HalfV0 + DeltaV);
+				const int64 EnterU = HalfU0 * DeltaV + (EnterV - HalfV0) * DeltaU;
+				const int64 LeaveU = HalfU0 * DeltaV + (LeaveV - HalfV0) * DeltaU;
+
+				// Cell U covers [2U, 2U + 2]
+				First = -FloorDivide(2 * DeltaV - FMath::Min(EnterU, LeaveU), 2 * DeltaV);
+				Last = FloorDivide(FMath::Max(EnterU, LeaveU), 2 * DeltaV);
+			}
+
+			First = FMath::Max<int64>(First, 0);
+			Last = FMath::Min<int64>(Last, LineLength - 1);
+			if (!Functor(V, int32(First), int32(Last)))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/*
+	 * Lines of Sight on Hex Grids: calls Functor(X, Y) for every Cell between both Cells, both excluded.
+	 * Stops once the Functor returns false. Lines along a Border between two Cells touch both,
+	 * so the Line is walked twice, nudged to either Side.
+	 * Uses Cube Coordinates, see https://www.redblobgames.com/grids/hexagons/#line-drawing
+	 */
+	template<typename FunctorType>
+	bool ForEachHexLineCell(const FIntPoint From, const FIntPoint To, FunctorType&& Functor)
+	{
+		const int32 FromQ = GetAxialColumn(From.X, From.Y);
+		const int32 DeltaQ = GetAxialColumn(To.X, To.Y) - FromQ;
+		const int32 DeltaR = To.Y - From.Y;
+		const int32 NumSteps = (FMath::Abs(DeltaQ) + FMath::Abs(DeltaR) + FMath::Abs(DeltaQ + DeltaR)) / 2;
+
+		for (const double Nudge : {1e-6, -1e-6})
+		{
+			for (int32 Step = 1; Step < NumSteps; Step++)
+			{
+				const double Alpha = double(Step) / NumSteps;
+				const double CubeQ = FromQ + Nudge + DeltaQ * Alpha;
+				const double CubeR = From.Y + Nudge + DeltaR * Alpha;
+				const double CubeS = -CubeQ - CubeR;
+
+				// Round to the nearest Cube, the Component with the largest Error gets fixed
+				int32 Q = FMath::RoundToInt32(CubeQ);
+				int32 R = FMath::RoundToInt32(CubeR);
+				const int32 S = FMath::RoundToInt32(CubeS);
+				const double ErrorQ = FMath::Abs(Q - CubeQ);
+				const double ErrorR = FMath::Abs(R - CubeR);
+				const double ErrorS = FMath::Abs(S - CubeS);
+				if (ErrorQ > ErrorR && ErrorQ > ErrorS)
+				{
+					Q = -R - S;
+				}
+				else if (ErrorR > ErrorS)
+				{
+					R = -Q - S;
+				}
+
+				if (!Functor(Q + (R - (R & 1)) / 2, R))
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+#if BYTES_GRID_AVX2 || BYTES_GRID_SSE4
+	// Lane Tables padded to 8 Lanes, so every Kernel can load them the same Way
+	struct FLaneTable
+	{
+		alignas(32) int32 DX[8];
+		alignas(32) int32 DY[8];
+		alignas(32) int32 Weight[8];
+		alignas(32) int32 Enabled[8];
+	};
+
+	FLaneTable MakeLaneTable(const EBytesGridConnectivity Connectivity, const int32 RowParity)
+	{
+		FLaneTable Table = {};
+		const bool bHex = Connectivity == EBytesGridConnectivity::Hex;
+		const int32 NumLanes = BytesGrid::GetNumLanes(Connectivity);
+		for (int32 Lane = 0; Lane < 8; Lane++)
+		{
+			const bool bEnabled = Lane < NumLanes;
+			Table.DX[Lane] = !bEnabled ? 0 : bHex ? BytesGrid::HexDX[RowParity][Lane] : BytesGrid::SquareDX[Lane];
+			Table.DY[Lane] = !bEnabled ? 0 : bHex ? BytesGrid::HexDY[Lane] : BytesGrid::SquareDY[Lane];
+			Table.Weight[Lane] = !bHex && Lane >= 4 ? FBytesGridGraph::DiagonalStepWeight : FBytesGridGraph::StepWeight;
+			Table.Enabled[Lane] = bEnabled ? -1 : 0;
+		}
+		return Table;
+	}
+
+	// [Connectivity][Row Parity], only Hex Grids differ between Rows
+	const FLaneTable LaneTables[3][2] =
+	{
+		{MakeLaneTable(EBytesGridConnectivity::Four, 0), MakeLaneTable(EBytesGridConnectivity::Four, 1)},
+		{MakeLaneTable(EBytesGridConnectivity::Eight, 0), MakeLaneTable(EBytesGridConnectivity::Eight, 1)},
+		{MakeLaneTable(EBytesGridConnectivity::Hex, 0), MakeLaneTable(EBytesGridConnectivity::Hex, 1)},
+	};
+#endif
+}
+
+FBytesGridGraph::FBytesGridGraph(const int32 InWidth, const int32 InHeight, const EBytesGridConnectivity InConnectivity)
+	: Width(FMath::Clamp(InWidth, 1, MaxSide))
+	, Height(FMath::Clamp(InHeight, 1, MaxSide))
+	, Connectivity(InConnectivity)
+{
+	if (Width != InWidth || Height != InHeight)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Grid Graph: %d x %d clamped to %d x %d"), InWidth, InHeight, Width, Height);
+	}
+
+	Costs.Init(1, NumNodes() + CostPadding);
+	CellsPerCost.Init(0, 256);
+	CellsPerCost[1] = NumNodes();
+
+	WordsPerRow = FMath::DivideAndRoundUp(Width, 64);
+	WordsPerColumn = FMath::DivideAndRoundUp(Height, 64);
+	RowBits.Init(0, WordsPerRow * Height);
+	ColumnBits.Init(0, WordsPerColumn * Width);
+	for (int32 Y = 0; Y < Height; Y++)
+	{
+		FillBitLine(&RowBits[Y * WordsPerRow], Width);
+	}
+	for (int32 X = 0; X < Width; X++)
+	{
+		FillBitLine(&ColumnBits[X * WordsPerColumn], Height);
+	}
+}
+
+void FBytesGridGraph::SetCellCost(const int32 NodeID, const uint8 Cost)
+{
+	if (NodeID < 0 || NodeID >= NumNodes())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Grid Graph: Cell %d is not in the Grid"), NodeID);
+		return;
+	}
+
+	const uint8 PreviousCost = Costs[NodeID];
+	if (PreviousCost == Cost)
+	{
+		return;
+	}
+
+	Costs[NodeID] = Cost;
+
+	// Blocked Cells do not count as a Cost
+	if (PreviousCost != 0 && --CellsPerCost[PreviousCost] == 0)
+	{
+		NumUsedCosts--;
+	}
+	if (Cost != 0 && CellsPerCost[Cost]++ == 0)
+	{
+		NumUsedCosts++;
+	}
+
+	// Lowest Cost any Cell still has. Only the last Cell of the cheapest Cost makes it search upwards
+	if (Cost != 0 && Cost < MinCost)
+	{
+		MinCost = Cost;
+	}
+	else if (PreviousCost == MinCost && CellsPerCost[MinCost] == 0 && NumUsedCosts > 0)
+	{
+		while (CellsPerCost[MinCost] == 0)
+		{
+			MinCost++;
+		}
+	}
+
+	const FIntPoint Cell = GetCell(NodeID);
+	SetBit(&RowBits[Cell.Y * WordsPerRow], Cell.X, Cost != 0);
+	SetBit(&ColumnBits[Cell.X * WordsPerColumn], Cell.Y, Cost != 0);
+}
+
+int32 FBytesGridGraph::ScanRow(const int32 X, const int32 Y, const int32 Step) const
+{
+	return ScanBitLine(&RowBits[Y * WordsPerRow], X, Step, Width);
+}
+
+int32 FBytesGridGraph::ScanColumn(const int32 X, const int32 Y, const int32 Step) const
+{
+	return ScanBitLine(&ColumnBits[X * WordsPerColumn], Y, Step, Height);
+}
+
+bool FBytesGridGraph::IsRectWalkable(const int32 MinX, const int32 MinY, const int32 MaxX, const int32 MaxY) const
+{
+	if (MinX < 0 || MinY < 0 || MaxX >= Width || MaxY >= Height || MinX > MaxX || MinY > MaxY)
+	{
+		return false;
+	}
+
+	// Fewer, longer Spans are cheaper
+	if (MaxX - MinX >= MaxY - MinY)
+	{
+		for (int32 Y = MinY; Y <= MaxY; Y++)
+		{
+			if (!IsBitSpanSet(&RowBits[Y * WordsPerRow], MinX, MaxX))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	for (int32 X = MinX; X <= MaxX; X++)
+	{
+		if (!IsBitSpanSet(&ColumnBits[X * WordsPerColumn], MinY, MaxY))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool FBytesGridGraph::HasLineOfSight(const int32 FromID, const int32 ToID) const
+{
+	if (!IsPassable(FromID) || !IsPassable(ToID))
+	{
+		return false;
+	}
+
+	const FIntPoint From = GetCell(FromID);
+	const FIntPoint To = GetCell(ToID);
+	if (Connectivity == EBytesGridConnectivity::Hex)
+	{
+		return ForEachHexLineCell(From, To, [this](const int32 X, const int32 Y)
+		{
+			return IsWalkable(X, Y);
+		});
+	}
+
+	// Shallow Lines cross few Rows with long Spans, steep Lines few Columns
+	if (FMath::Abs(To.X - From.X) >= FMath::Abs(To.Y - From.Y))
+	{
+		return ForEachSegmentSpan(From.X, From.Y, To.X, To.Y, Width, [this](const int32 Y, const int32 First, const int32 Last)
+		{
+			return IsBitSpanSet(&RowBits[Y * WordsPerRow], First, Last);
+		});
+	}
+	return ForEachSegmentSpan(From.Y, From.X, To.Y, To.X, Height, [this](const int32 X, const int32 First, const int32 Last)
+	{
+		return IsBitSpanSet(&ColumnBits[X * WordsPerColumn], First, Last);
+	});
+}
+
+int32 FBytesGridGraph::GetLineCost(const int32 FromID, const int32 ToID) const
+{
+	if (!HasLineOfSight(FromID, ToID))
+	{
+		return INDEX_NONE;
+	}
+
+	// Any touched Cell may be the most expensive one, on uniform Grids all of them cost the same
+	int32 MaxCost = FMath::Max(Costs[FromID], Costs[ToID]);
+	if (!HasUniformCost())
+	{
+		const FIntPoint From = GetCell(FromID);
+		const FIntPoint To = GetCell(ToID);
+		const auto VisitCell = [this, &MaxCost](const int32 X, const int32 Y)
+		{
+			MaxCost = FMath::Max<int32>(MaxCost, Costs[GetNodeID(X, Y)]);
+			return true;
+		};
+
+		if (Connectivity == EBytesGridConnectivity::Hex)
+		{
+			ForEachHexLineCell(From, To, VisitCell);
+		}
+		else if (FMath::Abs(To.X - From.X) >= FMath::Abs(To.Y - From.Y))
+		{
+			ForEachSegmentSpan(From.X, From.Y, To.X, To.Y, Width, [&VisitCell](const int32 Y, const int32 First, const int32 Last)
+			{
+				for (int32 X = First; X <= Last; X++)
+				{
+					VisitCell(X, Y);
+				}
+				return true;
+			});
+		}
+		else
+		{
+			ForEachSegmentSpan(From.Y, From.X, To.Y, To.X, Height, [&VisitCell](const int32 X, const int32 First, const int32 Last)
+			{
+				for (int32 Y = First; Y <= Last; Y++)
+				{
+					VisitCell(X, Y);
+				}
+				return true;
+			});
+		}
+	}
+
+	// Cells are CellSize apart and a Step between them weighs StepWeight. Hex Distances are not exact,
+	// without the Tolerance a straight Hex Line would cost more than its Steps
+	const double Length = FVector2D::Distance(GetLocation(FromID), GetLocation(ToID)) * StepWeight / CellSize;
+	return FMath::CeilToInt32(Length * MaxCost - UE_KINDA_SMALL_NUMBER);
+}
+
+int32 FBytesGridGraph::GetHeuristic(const int32 NodeID, const int32 TargetID) const
+{
+	const FIntPoint From = GetCell(NodeID);
+	const FIntPoint To = GetCell(TargetID);
+	const int32 DX = FMath::Abs(To.X - From.X);
+	const int32 DY = FMath::Abs(To.Y - From.Y);
+
+	int32 Distance = 0;
+	switch (Connectivity)
+	{
+	case EBytesGridConnectivity::Four:
+		Distance = StepWeight * (DX + DY);
+		break;
+	case EBytesGridConnectivity::Eight:
+		Distance = StepWeight * FMath::Max(DX, DY) + (DiagonalStepWeight - StepWeight) * FMath::Min(DX, DY);
+		break;
+	case EBytesGridConnectivity::Hex:
+	{
+		const int32 DQ = GetAxialColumn(To.X, To.Y) - GetAxialColumn(From.X, From.Y);
+		const int32 DR = To.Y - From.Y;
+		Distance = StepWeight * ((FMath::Abs(DQ) + FMath::Abs(DR) + FMath::Abs(DQ + DR)) / 2);
+		break;
+	}
+	}
+
+	return Distance * MinCost;
+}
+
+const TCHAR* FBytesGridGraph::GetKernelName() const
+{
+	if (!bUseSimd)
+	{
+		return TEXT("Scalar");
+	}
+#if BYTES_GRID_AVX2
+	return TEXT("AVX2");
+#elif BYTES_GRID_SSE4
+	return TEXT("SSE4.1");
+#else
+	return TEXT("Scalar");
+#endif
+}
+
+int32 FBytesGridGraph::ExpandNeighboursScalar(const int32 NodeID, const int32 GCost, const int32 TargetID, FBytesGridExpansion& OutExpansion) const
+{
+	OutExpansion.Num = 0;
+	ForEachStep(NodeID, [this, GCost, TargetID, &OutExpansion](const int32 NeighbourID, const int32 Weight)
+	{
+		const int32 Index = OutExpansion.Num++;
+		OutExpansion.NeighbourIDs[Index] = NeighbourID;
+		OutExpansion.GCosts[Index] = BytesSearch::AddCost(GCost, Weight * Costs[NeighbourID]);
+		OutExpansion.HCosts[Index] = GetHeuristic(NeighbourID, TargetID);
+	});
+	return OutExpansion.Num;
+}
+
+int32 FBytesGridGraph::ExpandNeighboursSimd(const int32 NodeID, const int32 GCost, const int32 TargetID, FBytesGridExpansion& OutExpansion) const
+{
+#if BYTES_GRID_AVX2 || BYTES_GRID_SSE4
+	if (Costs[NodeID] == 0)
+	{
+		OutExpansion.Num = 0;
+		return 0;
+	}
+
+	const FIntPoint Cell = GetCell(NodeID);
+	const FIntPoint Target = GetCell(TargetID);
+	const FLaneTable& Table = LaneTables[int32(Connectivity)][Cell.Y & 1];
+	const bool bHex = Connectivity == EBytesGridConnectivity::Hex;
+
+	// Every Lane gets written, Compaction below only copies the passable ones
+	alignas(32) int32 LaneIDs[8];
+	alignas(32) int32 LaneGCosts[8];
+	alignas(32) int32 LaneHCosts[8];
+	uint32 PassableLanes = 0;
+
+#if BYTES_GRID_AVX2
+	{
+		const __m256i Zero = _mm256_setzero_si256();
+		const __m256i DX = _mm256_load_si256(reinterpret_cast<const __m256i*>(Table.DX));
+		const __m256i DY = _mm256_load_si256(reinterpret_cast<const __m256i*>(Table.DY));
+		const __m256i X = _mm256_add_epi32(_mm256_set1_epi32(Cell.X), DX);
+		const __m256i Y = _mm256_add_epi32(_mm256_set1_epi32(Cell.Y), DY);
+
+		// Bounds of all Lanes at once
+		__m256i InBounds = _mm256_load_si256(reinterpret_cast<const __m256i*>(Table.Enabled));
+		InBounds = _mm256_and_si256(InBounds, _mm256_cmpgt_epi32(X, _mm256_set1_epi32(-1)));
+		InBounds = _mm256_and_si256(InBounds, _mm256_cmpgt_epi32(Y, _mm256_set1_epi32(-1)));
+		InBounds = _mm256_and_si256(InBounds, _mm256_cmpgt_epi32(_mm256_set1_epi32(Width), X));
+		InBounds = _mm256_and_si256(InBounds, _mm256_cmpgt_epi32(_mm256_set1_epi32(Height), Y));
+
+		// Only Lanes inside the Grid are gathered, the Padding covers the 3 Bytes behind the last Cell
+		const __m256i IDs = _mm256_add_epi32(_mm256_set1_epi32(NodeID), _mm256_add_epi32(_mm256_mullo_epi32(DY, _mm256_set1_epi32(Width)), DX));
+		__m256i CellCosts = _mm256_mask_i32gather_epi32(Zero, reinterpret_cast<const int*>(Costs.GetData()), IDs, InBounds, 1);
+		CellCosts = _mm256_and_si256(CellCosts, _mm256_set1_epi32(0xFF));
+		const __m256i Passable = _mm256_andnot_si256(_mm256_cmpeq_epi32(CellCosts, Zero), InBounds);
+		PassableLanes = uint32(_mm256_movemask_ps(_mm256_castsi256_ps(Passable)));
+
+		// GCost + Step Weight * Cell Cost, saturated at INITIAL_DISTANCE like "BytesSearch::AddCost()"
+		const __m256i Current = _mm256_set1_epi32(GCost);
+		const __m256i Sum = _mm256_add_epi32(Current, _mm256_mullo_epi32(CellCosts, _mm256_load_si256(reinterpret_cast<const __m256i*>(Table.Weight))));
+		const __m256i GCosts = _mm256_blendv_epi8(Sum, _mm256_set1_epi32(INITIAL_DISTANCE), _mm256_cmpgt_epi32(Current, Sum));
+
+		// Heuristic of every Lane, same Formulas as "GetHeuristic()"
+		const __m256i AbsDX = _mm256_abs_epi32(_mm256_sub_epi32(_mm256_set1_epi32(Target.X), X));
+		const __m256i AbsDY = _mm256_abs_epi32(_mm256_sub_epi32(_mm256_set1_epi32(Target.Y), Y));
+		__m256i Distance;
+		if (Connectivity == EBytesGridConnectivity::Four)
+		{
+			Distance = _mm256_mullo_epi32(_mm256_add_epi32(AbsDX, AbsDY), _mm256_set1_epi32(StepWeight));
+		}
+		else if (!bHex)
+		{
+			Distance = _mm256_add_epi32(
+				_mm256_mullo_epi32(_mm256_max_epi32(AbsDX, AbsDY), _mm256_set1_epi32(StepWeight)),
+				_mm256_mullo_epi32(_mm256_min_epi32(AbsDX, AbsDY), _mm256_set1_epi32(DiagonalStepWeight - StepWeight)));
+		}
+		else
+		{
+			const __m256i Q = _mm256_sub_epi32(X, _mm256_srai_epi32(_mm256_sub_epi32(Y, _mm256_and_si256(Y, _mm256_set1_epi32(1))), 1));
+			const __m256i DQ = _mm256_sub_epi32(_mm256_set1_epi32(GetAxialColumn(Target.X, Target.Y)), Q);
+			const __m256i DR = _mm256_sub_epi32(_mm256_set1_epi32(Target.Y), Y);
+			const __m256i Steps = _mm256_srli_epi32(_mm256_add_epi32(_mm256_add_epi32(_mm256_abs_epi32(DQ), _mm256_abs_epi32(DR)), _mm256_abs_epi32(_mm256_add_epi32(DQ, DR))), 1);
+			Distance = _mm256_mullo_epi32(Steps, _mm256_set1_epi32(StepWeight));
+		}
+		const __m256i HCosts = _mm256_mullo_epi32(Distance, _mm256_set1_epi32(MinCost));
+
+		_mm256_store_si256(reinterpret_cast<__m256i*>(LaneIDs), IDs);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(LaneGCosts), GCosts);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(LaneHCosts), HCosts);
+	}
+#else
+	// SSE4.1 has no Gather, so 4 Lanes per Pass and the Cell Costs are loaded one by one
+	const int32 NumPasses = BytesGrid::GetNumLanes(Connectivity) > 4 ? 2 : 1;
+	for (int32 Pass = 0; Pass < NumPasses; Pass++)
+	{
+		const int32 FirstLane = Pass * 4;
+		const __m128i Zero = _mm_setzero_si128();
+		const __m128i DX = _mm_load_si128(reinterpret_cast<const __m128i*>(Table.DX + FirstLane));
+		const __m128i DY = _mm_load_si128(reinterpret_cast<const __m128i*>(Table.DY + FirstLane));
+		const __m128i X = _mm_add_epi32(_mm_set1_epi32(Cell.X), DX);
+		const __m128i Y = _mm_add_epi32(_mm_set1_epi32(Cell.Y), DY);
+
+		__m128i InBounds = _mm_load_si128(reinterpret_cast<const __m128i*>(Table.Enabled + FirstLane));
+		InBounds = _mm_and_si128(InBounds, _mm_cmpgt_epi32(X, _mm_set1_epi32(-1)));
+		InBounds = _mm_and_si128(InBounds, _mm_cmpgt_epi32(Y, _mm_set1_epi32(-1)));
+		InBounds = _mm_and_si128(InBounds, _mm_cmplt_epi32(X, _mm_set1_epi32(Width)));
+		InBounds = _mm_and_si128(InBounds, _mm_cmplt_epi32(Y, _mm_set1_epi32(Height)));
+		const uint32 InBoundsLanes = uint32(_mm_movemask_ps(_mm_castsi128_ps(InBounds)));
+
+		const __m128i IDs = _mm_add_epi32(_mm_set1_epi32(NodeID), _mm_add_epi32(_mm_mullo_epi32(DY, _mm_set1_epi32(Width)), DX));
+		_mm_store_si128(reinterpret_cast<__m128i*>(LaneIDs + FirstLane), IDs);
+
+		alignas(16) int32 LaneCosts[4];
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			LaneCosts[Lane] = InBoundsLanes >> Lane & 1 ? Costs[LaneIDs[FirstLane + Lane]] : 0;
+		}
+		const __m128i CellCosts = _mm_load_si128(reinterpret_cast<const __m128i*>(LaneCosts));
+		const __m128i Passable = _mm_andnot_si128(_mm_cmpeq_epi32(CellCosts, Zero), InBounds);
+		PassableLanes |= uint32(_mm_movemask_ps(_mm_castsi128_ps(Passable))) << FirstLane;
+
+		const __m128i Current = _mm_set1_epi32(GCost);
+		const __m128i Sum = _mm_add_epi32(Current, _mm_mullo_epi32(CellCosts, _mm_load_si128(reinterpret_cast<const __m128i*>(Table.Weight + FirstLane))));
+		const __m128i GCosts = _mm_blendv_epi8(Sum, _mm_set1_epi32(INITIAL_DISTANCE), _mm_cmpgt_epi32(Current, Sum));
+
+		const __m128i AbsDX = _mm_abs_epi32(_mm_sub_epi32(_mm_set1_epi32(Target.X), X));
+		const __m128i AbsDY = _mm_abs_epi32(_mm_sub_epi32(_mm_set1_epi32(Target.Y), Y));
+		__m128i Distance;
+		if (Connectivity == EBytesGridConnectivity::Four)
+		{
+			Distance = _mm_mullo_epi32(_mm_add_epi32(AbsDX, AbsDY), _mm_set1_epi32(StepWeight));
+		}
+		else if (!bHex)
+		{
+			Distance = _mm_add_epi32(
+				_mm_mullo_epi32(_mm_max_epi32(AbsDX, AbsDY), _mm_set1_epi32(StepWeight)),
+				_mm_mullo_epi32(_mm_min_epi32(AbsDX, AbsDY), _mm_set1_epi32(DiagonalStepWeight - StepWeight)));
+		}
+		else
+		{
+			const __m128i Q = _mm_sub_epi32(X, _mm_srai_epi32(_mm_sub_epi32(Y, _mm_and_si128(Y, _mm_set1_epi32(1))), 1));
+			const __m128i DQ = _mm_sub_epi32(_mm_set1_epi32(GetAxialColumn(Target.X, Target.Y)), Q);
+			const __m128i DR = _mm_sub_epi32(_mm_set1_epi32(Target.Y), Y);
+			const __m128i Steps = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(_mm_abs_epi32(DQ), _mm_abs_epi32(DR)), _mm_abs_epi32(_mm_add_epi32(DQ, DR))), 1);
+			Distance = _mm_mullo_epi32(Steps, _mm_set1_epi32(StepWeight));
+		}
+		const __m128i HCosts = _mm_mullo_epi32(Distance, _mm_set1_epi32(MinCost));
+
+		_mm_store_si128(reinterpret_cast<__m128i*>(LaneGCosts + FirstLane), GCosts);
+		_mm_store_si128(reinterpret_cast<__m128i*>(LaneHCosts + FirstLane), HCosts);
+	}
+#endif
+
+	if (Connectivity == EBytesGridConnectivity::Eight)
+	{
+		PassableLanes = DropCornerCuts(PassableLanes);
+	}
+
+	// Compaction keeps the Lane Order, so both Kernels report Neighbours in the same Order
+	int32 Num = 0;
+	while (PassableLanes != 0)
+	{
+		const int32 Lane = FMath::CountTrailingZeros(PassableLanes);
+		PassableLanes &= PassableLanes - 1;
+
+		OutExpansion.NeighbourIDs[Num] = LaneIDs[Lane];
+		OutExpansion.GCosts[Num] = LaneGCosts[Lane];
+		OutExpansion.HCosts[Num] = LaneHCosts[Lane];
+		Num++;
+	}
+	OutExpansion.Num = Num;
+	return Num;
+#else
+	return ExpandNeighboursScalar(NodeID, GCost, TargetID, OutExpansion);
+#endif
+}
+
+void FBytesGridGraph::CopyToGraph(FBytesGraph& OutGraph) const
+{
+	const int32 NumCells = NumNodes();
+
+	TArray<FVector2D> Locations;
+	Locations.Reserve(NumCells);
+	bool bUniform = true;
+	for (int32 NodeID = 0; NodeID < NumCells; NodeID++)
+	{
+		Locations.Add(GetLocation(NodeID));
+		bUniform &= Costs[NodeID] == 0 || Costs[NodeID] == MinCost;
+	}
+
+	// Uneven Costs make Steps asymmetric, so the Graph needs directed Edges
+	TArray<int32> FromIDs;
+	TArray<int32> ToIDs;
+	TArray<int32> Weights;
+	for (int32 NodeID = 0; NodeID < NumCells; NodeID++)
+	{
+		ForEachNeighbour(NodeID, [&](const int32 NeighbourID, const int32 Weight)
+		{
+			if (!bUniform || NodeID < NeighbourID)
+			{
+				FromIDs.Add(NodeID);
+				ToIDs.Add(NeighbourID);
+				Weights.Add(Weight);
+			}
+		});
+	}
+
+	OutGraph = UBytesPathfinder::BuildGraph(Locations, FromIDs, ToIDs, Weights, !bUniform);
+	OutGraph.GraphType = Connectivity == EBytesGridConnectivity::Hex ? EBytesGraphType::Hexagonal : EBytesGraphType::Square;
+}
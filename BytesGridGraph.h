@@ -0,0 +1,447 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Pathfinding/BytesPathfinderSearch.h"
+
+// Vectorized Neighbour Expansion for Grids, see "FBytesGridGraph::ExpandNeighbours()".
+// Uses AVX2 or SSE4.1, whatever the Target Platform always has. Define BYTES_GRID_SIMD 0 to force the scalar Kernel
+#ifndef BYTES_GRID_SIMD
+	#define BYTES_GRID_SIMD 1
+#endif
+
+enum class EBytesGridConnectivity : uint8
+{
+	// Square Grid, no Diagonals
+	Four,
+	// Square Grid with Diagonals, Diagonals never cut a blocked Corner
+	Eight,
+	// Hex Grid, odd Rows are shifted half a Cell to the right like "UBytesPathfinderDebug::CreateHexGridGraph()"
+	Hex,
+};
+
+// Every passable Neighbour of one Cell with its tentative Costs, filled by "FBytesGridGraph::ExpandNeighbours()"
+struct FBytesGridExpansion
+{
+	static constexpr int32 MaxNeighbours = 8;
+
+	int32 Num = 0;
+	int32 NeighbourIDs[MaxNeighbours];
+	int32 GCosts[MaxNeighbours];
+	int32 HCosts[MaxNeighbours];
+};
+
+/*
+ * Implicit Square or Hex Grid: Neighbours are computed from the Cell, no Nodes or Edges are stored.
+ * The Node ID of a Cell is Y * Width + X, Cells are "CellSize" apart.
+ *
+ * Every Cell stores a single Byte of Cost: 0 is blocked, otherwise the Multiplier of the Step Weight for entering it.
+ * Orthogonal and Hex Steps weigh StepWeight, Diagonals DiagonalStepWeight, same as "UBytesPathfinderDebug::CreateSquareGridGraph()".
+ * Next to the Costs, a Bit per Cell marks the walkable Cells, once Row by Row and once Column by Column.
+ * Scans, Rectangles and Line of Sight test 64 Cells per Word on them.
+ *
+ * Works as Graph Accessor for the Search Templates in "BytesPathfinderSearch.h".
+ * "BytesSearch::GridAStar()" expands all Neighbours of a Cell in one Go instead, see "ExpandNeighbours()".
+ */
+class BYTESHEXGRIDPLUGIN_API FBytesGridGraph
+{
+public:
+	static constexpr double CellSize = 100.0;
+	static constexpr int32 StepWeight = 100;
+	static constexpr int32 DiagonalStepWeight = 142;
+
+	// Keeps every Heuristic and Step Cost inside int32
+	static constexpr int32 MaxSide = 32767;
+
+	FBytesGridGraph() = default;
+
+	// Every Cell starts passable with Cost 1. Sides are clamped to [1, MaxSide]
+	FBytesGridGraph(const int32 InWidth, const int32 InHeight, const EBytesGridConnectivity InConnectivity);
+
+	int32 GetWidth() const
+	{
+		return Width;
+	}
+
+	int32 GetHeight() const
+	{
+		return Height;
+	}
+
+	EBytesGridConnectivity GetConnectivity() const
+	{
+		return Connectivity;
+	}
+
+	int32 GetNodeID(const int32 X, const int32 Y) const
+	{
+		return Y * Width + X;
+	}
+
+	FIntPoint GetCell(const int32 NodeID) const
+	{
+		return FIntPoint(NodeID % Width, NodeID / Width);
+	}
+
+	uint8 GetCellCost(const int32 NodeID) const
+	{
+		return Costs[NodeID];
+	}
+
+	bool IsPassable(const int32 NodeID) const
+	{
+		return Costs[NodeID] != 0;
+	}
+
+	// 0 blocks the Cell
+	void SetCellCost(const int32 NodeID, const uint8 Cost);
+
+	// ==== Sub Section | Graph Accessor ==== //
+
+	int32 NumNodes() const
+	{
+		return Width * Height;
+	}
+
+	FVector2D GetLocation(const int32 NodeID) const
+	{
+		const FIntPoint Cell = GetCell(NodeID);
+		if (Connectivity == EBytesGridConnectivity::Hex)
+		{
+			return FVector2D((Cell.X + 0.5 * (Cell.Y & 1)) * CellSize, Cell.Y * CellSize * FMath::Sqrt(3.0) * 0.5);
+		}
+		return FVector2D(Cell.X * CellSize, Cell.Y * CellSize);
+	}
+
+	// No Step gets cheaper than the cheapest passable Cell makes it
+	double GetHeuristicScale() const
+	{
+		return MinCost;
+	}
+
+	template<typename FunctorType>
+	void ForEachNeighbour(const int32 NodeID, FunctorType&& Functor) const
+	{
+		ForEachStep(NodeID, [this, &Functor](const int32 NeighbourID, const int32 Weight)
+		{
+			Functor(NeighbourID, Weight * Costs[NeighbourID]);
+		});
+	}
+
+	// Every Incoming Step leads into NodeID, so they all share its Cost
+	template<typename FunctorType>
+	void ForEachIncomingNeighbour(const int32 NodeID, FunctorType&& Functor) const
+	{
+		const int32 Cost = Costs[NodeID];
+		ForEachStep(NodeID, [&Functor, Cost](const int32 SourceID, const int32 Weight)
+		{
+			Functor(SourceID, Weight * Cost);
+		});
+	}
+
+	// ==== Sub Section | Walkability ==== //
+
+	// Reads the Bit Layer, Cells outside the Grid are blocked
+	bool IsWalkable(const int32 X, const int32 Y) const
+	{
+		return X >= 0 && Y >= 0 && X < Width && Y < Height && (RowBits[Y * WordsPerRow + (X >> 6)] >> (X & 63) & 1) != 0;
+	}
+
+	// Walkable Cells after (X, Y) in Step Direction (+1 or -1), before the first blocked Cell or the Border
+	int32 ScanRow(const int32 X, const int32 Y, const int32 Step) const;
+	int32 ScanColumn(const int32 X, const int32 Y, const int32 Step) const;
+
+	// True if every Cell inside the Rectangle is walkable, Bounds included
+	bool IsRectWalkable(const int32 MinX, const int32 MinY, const int32 MaxX, const int32 MaxY) const;
+
+	/*
+	 * True if the straight Line between both Cell Centers only touches walkable Cells, touched Corners included,
+	 * so Lines never squeeze between two diagonal Obstacles. Square Grids test a whole Span of Cells per Row
+	 * (or Column for steep Lines) at once, Hex Grids walk the Cells along the Line.
+	 */
+	bool HasLineOfSight(const int32 FromID, const int32 ToID) const;
+
+	/*
+	 * Cost of walking straight from FromID to ToID, or -1 without Line of Sight. The Line is charged the Step Cost
+	 * of the most expensive Cell it touches per StepWeight of Length, so it never costs less than walking it Cell by Cell would.
+	 */
+	int32 GetLineCost(const int32 FromID, const int32 ToID) const;
+
+	// Every walkable Cell has the same Cost
+	bool HasUniformCost() const
+	{
+		return NumUsedCosts <= 1;
+	}
+
+	// ==== Sub Section | Grid Search ==== //
+
+	/*
+	 * Octile Distance on Square Grids with Diagonals, Manhattan Distance without and Hex Distance on Hex Grids,
+	 * scaled by the cheapest Cell. Stronger than the Euclidean Heuristic and still consistent.
+	 */
+	int32 GetHeuristic(const int32 NodeID, const int32 TargetID) const;
+
+	/*
+	 * Writes every passable Neighbour of NodeID with GCost + Step Cost and its Heuristic towards TargetID into OutExpansion.
+	 * Neighbours, Bounds, Costs and Heuristics of all Lanes are computed together with SIMD if available.
+	 * Returns the Number of Neighbours, same Order and Values as the scalar Kernel.
+	 */
+	int32 ExpandNeighbours(const int32 NodeID, const int32 GCost, const int32 TargetID, FBytesGridExpansion& OutExpansion) const
+	{
+#if BYTES_GRID_SIMD
+		if (bUseSimd)
+		{
+			return ExpandNeighboursSimd(NodeID, GCost, TargetID, OutExpansion);
+		}
+#endif
+		return ExpandNeighboursScalar(NodeID, GCost, TargetID, OutExpansion);
+	}
+
+	// Benchmarks compare both Kernels on the same Grid. Without BYTES_GRID_SIMD the scalar Kernel is always used
+	void SetSimdEnabled(const bool bEnabled)
+	{
+		bUseSimd = bEnabled;
+	}
+
+	// Name of the Kernel "ExpandNeighbours()" runs, e.g. for Benchmark Logs
+	const TCHAR* GetKernelName() const;
+
+	// Builds an explicit Graph with the same Node ID's, blocked Cells become isolated Nodes
+	void CopyToGraph(FBytesGraph& OutGraph) const;
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Costs.GetAllocatedSize() + RowBits.GetAllocatedSize() + ColumnBits.GetAllocatedSize() + CellsPerCost.GetAllocatedSize();
+	}
+
+private:
+	int32 Width = 0;
+	int32 Height = 0;
+	EBytesGridConnectivity Connectivity = EBytesGridConnectivity::Eight;
+
+	// One Byte per Cell plus Padding, so the AVX2 Kernel can gather 4 Bytes at the last Cell
+	TArray<uint8> Costs;
+
+	// Walkable Bits, Row Y starts at Word Y * WordsPerRow and Column X at Word X * WordsPerColumn.
+	// Bits behind the last Cell of a Line stay 0, so Scans stop at the Border on their own
+	TArray<uint64> RowBits;
+	TArray<uint64> ColumnBits;
+	int32 WordsPerRow = 0;
+	int32 WordsPerColumn = 0;
+
+	// Cells per Cost Byte, tells if the Grid is uniform without looking at every Cell
+	TArray<int32> CellsPerCost;
+	int32 NumUsedCosts = 1;
+
+	// Lowest Cost with any Cells in "CellsPerCost", stays at the last one once every Cell is blocked
+	uint8 MinCost = 1;
+	bool bUseSimd = true;
+
+	int32 ExpandNeighboursScalar(const int32 NodeID, const int32 GCost, const int32 TargetID, FBytesGridExpansion& OutExpansion) const;
+	int32 ExpandNeighboursSimd(const int32 NodeID, const int32 GCost, const int32 TargetID, FBytesGridExpansion& OutExpansion) const;
+
+	// Calls Functor(NeighbourID, Step Weight) for every passable Neighbour of a passable Cell, in Kernel Lane Order
+	template<typename FunctorType>
+	void ForEachStep(const int32 NodeID, FunctorType&& Functor) const;
+};
+
+namespace BytesGrid
+{
+	/*
+	 * Kernel Lanes: Neighbour Offset and Step Weight of every Direction.
+	 * Square Grids: 4 Orthogonals, then 4 Diagonals. Diagonal Lane 4 + I needs both Orthogonal Lanes in DiagonalSides[I].
+	 * Hex Grids use 6 Lanes, Offsets depend on the Row Parity.
+	 */
+	constexpr int32 SquareDX[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+	constexpr int32 SquareDY[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+	constexpr int32 DiagonalSides[4][2] = {{0, 2}, {1, 2}, {0, 3}, {1, 3}};
+
+	constexpr int32 HexDX[2][6] = {{1, -1, -1, 0, -1, 0}, {1, -1, 0, 1, 0, 1}};
+	constexpr int32 HexDY[6] = {0, 0, -1, -1, 1, 1};
+
+	inline int32 GetNumLanes(const EBytesGridConnectivity Connectivity)
+	{
+		return Connectivity == EBytesGridConnectivity::Four ? 4 : Connectivity == EBytesGridConnectivity::Hex ? 6 : 8;
+	}
+}
+
+template<typename FunctorType>
+void FBytesGridGraph::ForEachStep(const int32 NodeID, FunctorType&& Functor) const
+{
+	// Blocked Cells are isolated, even Searches starting on one go nowhere
+	if (Costs[NodeID] == 0)
+	{
+		return;
+	}
+
+	const FIntPoint Cell = GetCell(NodeID);
+	const bool bHex = Connectivity == EBytesGridConnectivity::Hex;
+	const int32 NumLanes = BytesGrid::GetNumLanes(Connectivity);
+
+	uint32 PassableLanes = 0;
+	for (int32 Lane = 0; Lane < NumLanes; Lane++)
+	{
+		const int32 X = Cell.X + (bHex ? BytesGrid::HexDX[Cell.Y & 1][Lane] : BytesGrid::SquareDX[Lane]);
+		const int32 Y = Cell.Y + (bHex ? BytesGrid::HexDY[Lane] : BytesGrid::SquareDY[Lane]);
+		if (X < 0 || Y < 0 || X >= Width || Y >= Height || Costs[GetNodeID(X, Y)] == 0)
+		{
+			continue;
+		}
+
+		// Diagonals only after both of their Sides are known
+		if (!bHex && Lane >= 4)
+		{
+			const int32* Sides = BytesGrid::DiagonalSides[Lane - 4];
+			if (!(PassableLanes >> Sides[0] & 1) || !(PassableLanes >> Sides[1] & 1))
+			{
+				continue;
+			}
+		}
+
+		PassableLanes |= 1u << Lane;
+		Functor(GetNodeID(X, Y), !bHex && Lane >= 4 ? DiagonalStepWeight : StepWeight);
+	}
+}
+
+// Heuristic Policy for the Search Templates, see "FBytesGridGraph::GetHeuristic()"
+struct FBytesGridHeuristic
+{
+	int32 operator()(const FBytesGridGraph& Graph, const int32 NodeID, const int32 TargetID) const
+	{
+		return Graph.GetHeuristic(NodeID, TargetID);
+	}
+};
+
+// Line of Sight Policy for "BytesSearch::ThetaStar()", tests the Walkable Bits instead of walking Neighbours
+struct FBytesGridLineOfSight
+{
+	bool operator()(const FBytesGridGraph& Graph, const int32 FromID, const int32 ToID, int32& OutCost) const
+	{
+		OutCost = Graph.GetLineCost(FromID, ToID);
+		return OutCost != INDEX_NONE;
+	}
+};
+
+namespace BytesSearch
+{
+	/*
+	 * Fast Path for "GridAStar()": on a uniform Square Grid without Obstacles in the Rectangle between Start and Target,
+	 * Diagonals first and then a straight Line is an optimal Path. Writes it into State without searching,
+	 * returns false if the Grid does not allow it.
+	 */
+	inline bool TryStraightGridPath(const FBytesGridGraph& Grid, FBytesSearchState& State, const int32 StartID, const int32 TargetID)
+	{
+		if (Grid.GetConnectivity() == EBytesGridConnectivity::Hex || !Grid.HasUniformCost() || !Grid.IsPassable(StartID))
+		{
+			return false;
+		}
+
+		const FIntPoint Start = Grid.GetCell(StartID);
+		const FIntPoint Target = Grid.GetCell(TargetID);
+		if (!Grid.IsRectWalkable(FMath::Min(Start.X, Target.X), FMath::Min(Start.Y, Target.Y), FMath::Max(Start.X, Target.X), FMath::Max(Start.Y, Target.Y)))
+		{
+			return false;
+		}
+
+		State.Init(Grid.NumNodes(), INITIAL_DISTANCE);
+		State.GCost[StartID] = 0;
+
+		const bool bDiagonal = Grid.GetConnectivity() == EBytesGridConnectivity::Eight;
+		const int32 StepX = FMath::Sign(Target.X - Start.X);
+		const int32 StepY = FMath::Sign(Target.Y - Start.Y);
+		FIntPoint Cell = Start;
+		int32 CurrentID = StartID;
+		while (CurrentID != TargetID)
+		{
+			const bool bMoveX = Cell.X != Target.X;
+			const bool bMoveY = Cell.Y != Target.Y && (bDiagonal || !bMoveX);
+			Cell.X += bMoveX ? StepX : 0;
+			Cell.Y += bMoveY ? StepY : 0;
+
+			const int32 NextID = Grid.GetNodeID(Cell.X, Cell.Y);
+			const int32 Weight = bMoveX && bMoveY ? FBytesGridGraph::DiagonalStepWeight : FBytesGridGraph::StepWeight;
+			State.GCost[NextID] = AddCost(State.GCost[CurrentID], Weight * Grid.GetCellCost(NextID));
+			State.ParentID[NextID] = CurrentID;
+			CurrentID = NextID;
+		}
+		return true;
+	}
+
+	/*
+	 * A* on an implicit Grid, with the Grid Heuristic. Same Costs as "AStar<QueueType, FBytesGridHeuristic>()",
+	 * but every Expansion computes all Neighbours at once and open Rectangles skip the Search, see "TryStraightGridPath()".
+	 * Returns true if the Target has been reached. Stats is optional.
+	 */
+	template<typename QueueType = FBytesIndexedQueue>
+	bool GridAStar(const FBytesGridGraph& Grid, FBytesSearchState& State, const int32 StartID, const int32 TargetID, FBytesSearchStats* Stats = nullptr)
+	{
+		BYTES_SEARCH_STAT_TIMER();
+
+		if (TryStraightGridPath(Grid, State, StartID, TargetID))
+		{
+			return true;
+		}
+
+		const int32 NumNodes = Grid.NumNodes();
+		State.Init(NumNodes, INITIAL_DISTANCE);
+
+		QueueType OpenSet(State, NumNodes);
+		TBitArray<> ClosedSet(false, NumNodes);
+		FBytesGridExpansion Expansion;
+
+		State.GCost[StartID] = 0;
+		State.HCost[StartID] = Grid.GetHeuristic(StartID, TargetID);
+		OpenSet.Push(StartID);
+		BYTES_SEARCH_STAT(Stats->HeapPushes++);
+		BYTES_SEARCH_STAT(Stats->PeakOpenSetSize = FMath::Max<int64>(Stats->PeakOpenSetSize, 1));
+
+		while (true)
+		{
+			const int32 CurrentID = OpenSet.Pop();
+			if (CurrentID == INDEX_NONE)
+			{
+				return false;
+			}
+
+			ClosedSet[CurrentID] = true;
+			BYTES_SEARCH_STAT(Stats->HeapPops++);
+			BYTES_SEARCH_STAT(Stats->NodesExpanded++);
+
+			if (CurrentID == TargetID)
+			{
+				return true;
+			}
+
+			const int32 NumNeighbours = Grid.ExpandNeighbours(CurrentID, State.GCost[CurrentID], TargetID, Expansion);
+			BYTES_SEARCH_STAT(Stats->NodesGenerated += NumNeighbours);
+
+			for (int32 Index = 0; Index < NumNeighbours; Index++)
+			{
+				const int32 NeighbourID = Expansion.NeighbourIDs[Index];
+				const int32 MovementCost = Expansion.GCosts[Index];
+				if (ClosedSet[NeighbourID] || MovementCost >= State.GCost[NeighbourID])
+				{
+					continue;
+				}
+
+				if (State.GCost[NeighbourID] == INITIAL_DISTANCE)
+				{
+					State.HCost[NeighbourID] = Expansion.HCosts[Index];
+				}
+				State.ParentID[NeighbourID] = CurrentID;
+				State.GCost[NeighbourID] = MovementCost;
+
+				if (OpenSet.Push(NeighbourID))
+				{
+					BYTES_SEARCH_STAT(Stats->HeapUpdates++);
+				}
+				else
+				{
+					BYTES_SEARCH_STAT(Stats->HeapPushes++);
+					BYTES_SEARCH_STAT(Stats->PeakOpenSetSize = FMath::Max<int64>(Stats->PeakOpenSetSize, OpenSet.Num()));
+				}
+			}
+		}
+	}
+}
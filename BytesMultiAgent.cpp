@@ -0,0 +1,671 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#include "Pathfinding/BytesMultiAgent.h"
+#include "Pathfinding/BytesPathfinderSearch.h"
+#include "Pathfinding/BytesPathfinderTrace.h"
+
+namespace
+{
+	/*
+	 * (Node, Turn) Pairs of one Agent as a Graph, each Turn it waits for WaitCost or steps over one Edge.
+	 * Pair IDs are Time * NumNodes + NodeID. Turns past LastTime are all the same, they fold into LastTime.
+	 * Every Pair that IsGoal accepts has an Edge to one virtual Goal Node, weighted with the Cost left to the Target,
+	 * so A* towards the Goal Node ends on the cheapest Pair that may stop the Plan.
+	 */
+	template<typename IsNodeFreeType, typename IsMoveFreeType, typename IsGoalType>
+	struct TSpaceTimeGraph
+	{
+		const FBytesGraph& Graph;
+		const TArray<int32>& TargetCosts;
+		const int32 GraphNodes;
+		const int32 WaitCost;
+		const int32 LastTime;
+		IsNodeFreeType& IsNodeFree;
+		IsMoveFreeType& IsMoveFree;
+		IsGoalType& IsGoal;
+
+		int32 NumNodes() const
+		{
+			return GetGoalID() + 1;
+		}
+
+		int32 GetGoalID() const
+		{
+			return (LastTime + 1) * GraphNodes;
+		}
+
+		int32 GetTargetCost(const int32 PairID) const
+		{
+			return PairID == GetGoalID() ? 0 : TargetCosts[PairID % GraphNodes];
+		}
+
+		template<typename FunctorType>
+		void ForEachNeighbour(const int32 PairID, FunctorType&& Functor) const
+		{
+			if (PairID == GetGoalID())
+			{
+				return;
+			}
+
+			const int32 CurrentID = PairID % GraphNodes;
+			const int32 Time = PairID / GraphNodes;
+			const int32 ArrivalTime = Time + 1;
+			const int32 NextPairOffset = FMath::Min(ArrivalTime, LastTime) * GraphNodes;
+
+			if (IsGoal(CurrentID, Time))
+			{
+				Functor(GetGoalID(), TargetCosts[CurrentID]);
+			}
+
+			if (Time < LastTime && IsNodeFree(CurrentID, ArrivalTime))
+			{
+				Functor(NextPairOffset + CurrentID, WaitCost);
+			}
+
+			FBytesGraphAccessor(Graph).ForEachNeighbour(CurrentID, [&](const int32 NeighbourID, const int32 Weight)
+			{
+				if (TargetCosts[NeighbourID] == INITIAL_DISTANCE || NeighbourID == CurrentID
+					|| !IsNodeFree(NeighbourID, ArrivalTime) || !IsMoveFree(CurrentID, NeighbourID, ArrivalTime))
+				{
+					return;
+				}
+				Functor(NextPairOffset + NeighbourID, Weight);
+			});
+		}
+	};
+
+	/*
+	 * Space Time A* of one Agent, see "TSpaceTimeGraph". Runs "BytesSearch::AStar" on the sparse State, only reached Pairs cost Memory.
+	 * Writes the Steps up to the first Pair that IsGoal accepts into OutSteps and returns the Cost plus the Cost left to the Target,
+	 * INDEX_NONE if no Goal can be reached or the Pairs do not fit into int32 IDs.
+	 */
+	template<typename IsNodeFreeType, typename IsMoveFreeType, typename IsGoalType>
+	int64 SpaceTimeAStar(const FBytesGraph& Graph, const TArray<int32>& TargetCosts, const int32 StartID, const int32 WaitCost, const int32 LastTime,
+		IsNodeFreeType&& IsNodeFree, IsMoveFreeType&& IsMoveFree, IsGoalType&& IsGoal, FBytesSparseSearchState& State, TArray<int32>& OutSteps, FBytesSearchStats* Stats)
+	{
+		const int32 GraphNodes = Graph.Nodes.Num();
+		if (int64(LastTime + 1) * GraphNodes >= MAX_int32)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Space Time A*: %d Turns over %d Nodes do not fit into int32 IDs"), LastTime + 1, GraphNodes);
+			return INDEX_NONE;
+		}
+		if (TargetCosts[StartID] == INITIAL_DISTANCE || !IsNodeFree(StartID, 0))
+		{
+			return INDEX_NONE;
+		}
+
+		using FSpaceTimeGraph = TSpaceTimeGraph<IsNodeFreeType, IsMoveFreeType, IsGoalType>;
+		const FSpaceTimeGraph SpaceTimeGraph{Graph, TargetCosts, GraphNodes, WaitCost, LastTime, IsNodeFree, IsMoveFree, IsGoal};
+		const int32 GoalID = SpaceTimeGraph.GetGoalID();
+
+		if (!BytesSearch::AStar<FBytesSparseLazyQueue, FBytesTargetCostHeuristic>(SpaceTimeGraph, State, StartID, GoalID, Stats))
+		{
+			return INDEX_NONE;
+		}
+
+		// Pairs back to Nodes, the Goal Node is no Step
+		const TArray<int32> Pairs = BytesSearch::RetracePath(State, StartID, GoalID);
+		OutSteps.Reset(Pairs.Num());
+		OutSteps.Add(StartID);
+		for (int32 PairIndex = 0; PairIndex < Pairs.Num() - 1; PairIndex++)
+		{
+			OutSteps.Add(Pairs[PairIndex] % GraphNodes);
+		}
+		return State.GCost[GoalID];
+	}
+
+	// No other Agent stands on the Target from Time until the Window ends
+	bool CanStayOnTarget(const FBytesReservationTable& Reservations, const int32 TargetID, const int32 Time, const int32 WindowSize, const int32 AgentID)
+	{
+		for (int32 Turn = Time; Turn <= WindowSize; Turn++)
+		{
+			if (!Reservations.IsNodeFree(TargetID, Turn, AgentID))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/*
+	 * Plan of one Agent around the Reservations. Ends on the Target once the Agent can stay there,
+	 * or on any Node once the Window is over. Returns false if no Steps fit.
+	 */
+	bool PlanAgent(const FBytesGraph& Graph, const FBytesReservationTable& Reservations, const TArray<int32>& TargetCosts, const int32 AgentID,
+		const FBytesAgentRequest& Agent, const int32 WindowSize, const int32 WaitCost, FBytesSparseSearchState& State, FBytesAgentPlan& OutPlan, FBytesSearchStats* Stats)
+	{
+		OutPlan.EstimatedCost = SpaceTimeAStar(Graph, TargetCosts, Agent.StartID, WaitCost, WindowSize,
+			[&](const int32 NodeID, const int32 Time) { return Reservations.IsNodeFree(NodeID, Time, AgentID); },
+			[&](const int32 FromID, const int32 ToID, const int32 Time) { return Reservations.IsMoveFree(FromID, ToID, Time, AgentID); },
+			[&](const int32 NodeID, const int32 Time)
+			{
+				return Time >= WindowSize || NodeID == Agent.TargetID && CanStayOnTarget(Reservations, Agent.TargetID, Time, WindowSize, AgentID);
+			},
+			State, OutPlan.Steps, Stats);
+		if (OutPlan.EstimatedCost == INDEX_NONE)
+		{
+			return false;
+		}
+
+		// Turns past the Window fold into its last Turn, like in the Search
+		const int32 LastTime = FMath::Min(OutPlan.Steps.Num() - 1, WindowSize);
+		OutPlan.bReachesTarget = OutPlan.Steps.Last() == Agent.TargetID && CanStayOnTarget(Reservations, Agent.TargetID, LastTime, WindowSize, AgentID);
+		return true;
+	}
+
+	// ==== Sub Section | Conflict Based Search ==== //
+
+	// Agent may not be on NodeID in Turn Time, or not arrive there from FromID if it is no INDEX_NONE
+	struct FAgentConstraint
+	{
+		int32 AgentID = INDEX_NONE;
+		int32 FromID = INDEX_NONE;
+		int32 NodeID = INDEX_NONE;
+		int32 Time = 0;
+
+		bool operator==(const FAgentConstraint& Other) const
+		{
+			return AgentID == Other.AgentID && FromID == Other.FromID && NodeID == Other.NodeID && Time == Other.Time;
+		}
+
+		bool operator<(const FAgentConstraint& Other) const
+		{
+			return Time != Other.Time ? Time < Other.Time : NodeID != Other.NodeID ? NodeID < Other.NodeID : FromID < Other.FromID;
+		}
+	};
+
+	// Sorted Constraints of one Agent, the same Set always gives the same Plan
+	struct FConstraintSetKey
+	{
+		int32 AgentID = INDEX_NONE;
+		TArray<FAgentConstraint> Constraints;
+
+		bool operator==(const FConstraintSetKey& Other) const
+		{
+			return AgentID == Other.AgentID && Constraints == Other.Constraints;
+		}
+
+		friend uint32 GetTypeHash(const FConstraintSetKey& Key)
+		{
+			uint32 Hash = GetTypeHash(Key.AgentID);
+			for (const FAgentConstraint& Constraint : Key.Constraints)
+			{
+				Hash = HashCombineFast(Hash, HashCombineFast(HashCombineFast(GetTypeHash(Constraint.FromID), GetTypeHash(Constraint.NodeID)), GetTypeHash(Constraint.Time)));
+			}
+			return Hash;
+		}
+	};
+
+	// Result of one Single Agent Search, Cost is INDEX_NONE if the Constraints leave no Path
+	struct FAgentSearch
+	{
+		TArray<int32> Steps;
+		int64 Cost = INDEX_NONE;
+	};
+
+	// Node of the Constraint Tree. Adds one Constraint to its Parent and points at the Search of every Agent
+	struct FConstraintNode
+	{
+		int32 ParentIndex = INDEX_NONE;
+		FAgentConstraint Constraint;
+		TArray<int32> SearchIndices;
+		int64 Cost = 0;
+		int32 NumConflicts = 0;
+	};
+
+	struct FConstraintEntry
+	{
+		int64 Cost;
+		int32 NumConflicts;
+		int32 NodeIndex;
+
+		// Cheapest first, Ties go to the Node with fewer Conflicts
+		static bool HasHigherPriority(const FConstraintEntry& A, const FConstraintEntry& B)
+		{
+			return A.Cost < B.Cost || A.Cost == B.Cost && A.NumConflicts < B.NumConflicts;
+		}
+	};
+
+	// Two Agents on NodeA in Turn Time, or swapping NodeA and NodeB if bSwap. AgentA came from NodeB then
+	struct FAgentConflict
+	{
+		int32 AgentA = INDEX_NONE;
+		int32 AgentB = INDEX_NONE;
+		int32 Time = MAX_int32;
+		int32 NodeA = INDEX_NONE;
+		int32 NodeB = INDEX_NONE;
+		bool bSwap = false;
+	};
+
+	/*
+	 * Pairs of Step Lists that meet on a Node or swap Nodes, Agents stay on their last Step. Lists may be empty.
+	 * Adds the earliest Conflict of every Pair to OutConflicts if given.
+	 */
+	int32 FindConflicts(const TArray<const TArray<int32>*>& Steps, TArray<FAgentConflict>* OutConflicts)
+	{
+		int32 NumTurns = 0;
+		for (const TArray<int32>* AgentSteps : Steps)
+		{
+			NumTurns = FMath::Max(NumTurns, AgentSteps->Num());
+		}
+
+		const auto GetNode = [](const TArray<int32>& AgentSteps, const int32 Turn)
+		{
+			return AgentSteps.IsEmpty() ? INDEX_NONE : AgentSteps[FMath::Min(Turn, AgentSteps.Num() - 1)];
+		};
+
+		int32 NumConflicts = 0;
+		for (int32 IndexA = 0; IndexA < Steps.Num(); IndexA++)
+		{
+			for (int32 IndexB = IndexA + 1; IndexB < Steps.Num(); IndexB++)
+			{
+				for (int32 Turn = 0; Turn < NumTurns; Turn++)
+				{
+					const int32 NodeA = GetNode(*Steps[IndexA], Turn);
+					const int32 NodeB = GetNode(*Steps[IndexB], Turn);
+					const bool bSameNode = NodeA != INDEX_NONE && NodeA == NodeB;
+					const bool bSwap = Turn > 0 && NodeA != NodeB && NodeA == GetNode(*Steps[IndexB], Turn - 1) && NodeB == GetNode(*Steps[IndexA], Turn - 1);
+					if (bSameNode || bSwap)
+					{
+						NumConflicts++;
+						if (OutConflicts)
+						{
+							OutConflicts->Add({IndexA, IndexB, Turn, NodeA, NodeB, bSwap});
+						}
+						break;
+					}
+				}
+			}
+		}
+		return NumConflicts;
+	}
+
+	// Cheapest Plan of one Agent that keeps its Constraints. It may only end on the Target after the last Constraint there
+	FAgentSearch PlanConstrainedAgent(const FBytesGraph& Graph, const TArray<int32>& TargetCosts, const FBytesAgentRequest& Agent,
+		const TArray<FAgentConstraint>& Constraints, const int32 WaitCost, FBytesSparseSearchState& State, FBytesSearchStats* Stats)
+	{
+		TSet<FBytesSpaceTimeKey> BlockedNodes;
+		TSet<FBytesSpaceTimeMove> BlockedMoves;
+		int32 LastTime = 0;
+		int32 FirstGoalTime = 0;
+		for (const FAgentConstraint& Constraint : Constraints)
+		{
+			if (Constraint.FromID == INDEX_NONE)
+			{
+				BlockedNodes.Add({Constraint.NodeID, Constraint.Time});
+			}
+			else
+			{
+				BlockedMoves.Add({Constraint.FromID, Constraint.NodeID, Constraint.Time});
+			}
+			LastTime = FMath::Max(LastTime, Constraint.Time + 1);
+			if (Constraint.NodeID == Agent.TargetID && Constraint.FromID == INDEX_NONE)
+			{
+				FirstGoalTime = FMath::Max(FirstGoalTime, Constraint.Time + 1);
+			}
+		}
+
+		FAgentSearch Search;
+		Search.Cost = SpaceTimeAStar(Graph, TargetCosts, Agent.StartID, WaitCost, LastTime,
+			[&](const int32 NodeID, const int32 Time) { return !BlockedNodes.Contains({NodeID, Time}); },
+			[&](const int32 FromID, const int32 ToID, const int32 Time) { return !BlockedMoves.Contains({FromID, ToID, Time}); },
+			[&](const int32 NodeID, const int32 Time) { return NodeID == Agent.TargetID && Time >= FirstGoalTime; },
+			State, Search.Steps, Stats);
+		return Search;
+	}
+}
+
+void FBytesReservationTable::ReservePath(const TArray<int32>& Steps, const int32 AgentID)
+{
+	for (int32 Turn = 0; Turn < Steps.Num(); Turn++)
+	{
+		ReserveNode(Steps[Turn], Turn, AgentID);
+		if (Turn > 0 && Steps[Turn] != Steps[Turn - 1])
+		{
+			ReserveMove(Steps[Turn - 1], Steps[Turn], Turn, AgentID);
+		}
+	}
+}
+
+int32 UBytesMultiAgent::PlanCooperativePaths(FBytesGraph& Graph, FBytesCooperativePlanner& Planner, const TArray<FBytesAgentRequest>& Agents, TArray<FBytesAgentPlan>& OutPlans)
+{
+	BYTES_TRACE_SCOPE("PlanCooperativePaths");
+
+	OutPlans.Reset();
+	OutPlans.SetNum(Agents.Num());
+	Planner.Reservations.Reset();
+	Planner.LastStats = FBytesSearchStats();
+#if BYTES_PATHFINDER_STATS
+	FBytesSearchStats* Stats = &Planner.LastStats;
+#else
+	FBytesSearchStats* Stats = nullptr;
+#endif
+
+	const int32 WindowSize = FMath::Max(Planner.WindowSize, 1);
+	const int32 WaitCost = FMath::Max(Planner.WaitCost, 0);
+
+	Graph.TargetCostCache.Trim(Agents.Num());
+
+	// Agents that wait on their Start for the whole Window, every other Agent plans around them
+	TBitArray<> Waiting(false, Agents.Num());
+	for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+	{
+		const FBytesAgentRequest& Agent = Agents[AgentID];
+		if (!Graph.IsValidNode(Agent.StartID) || !Graph.IsValidNode(Agent.TargetID))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's for Agent %d. Out of Range"), AgentID);
+			OutPlans[AgentID].bBlocked = true;
+			continue;
+		}
+		if (Graph.TargetCostCache.FindOrBuild(Graph, Agent.TargetID)[Agent.StartID] == INITIAL_DISTANCE)
+		{
+			Waiting[AgentID] = true;
+		}
+	}
+
+	// Planning Order, Agents that found no Steps move to the Front once
+	TArray<int32> Order;
+	for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+	{
+		Order.Add(AgentID);
+	}
+	TBitArray<> MovedToFront(false, Agents.Num());
+
+	bool bPlanned = false;
+	while (!bPlanned)
+	{
+		Planner.Reservations.Reset();
+		for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+		{
+			if (Waiting[AgentID])
+			{
+				for (int32 Turn = 0; Turn <= WindowSize; Turn++)
+				{
+					Planner.Reservations.ReserveNode(Agents[AgentID].StartID, Turn, AgentID);
+				}
+			}
+		}
+
+		bPlanned = true;
+		for (int32 OrderIndex = 0; OrderIndex < Order.Num(); OrderIndex++)
+		{
+			const int32 AgentID = Order[OrderIndex];
+			const FBytesAgentRequest& Agent = Agents[AgentID];
+			FBytesAgentPlan& Plan = OutPlans[AgentID];
+			if (Waiting[AgentID] || Plan.bBlocked)
+			{
+				continue;
+			}
+
+			Plan = FBytesAgentPlan();
+			const TArray<int32>& TargetCosts = Graph.TargetCostCache.FindOrBuild(Graph, Agent.TargetID);
+			if (PlanAgent(Graph, Planner.Reservations, TargetCosts, AgentID, Agent, WindowSize, WaitCost, Graph.SparseSearchState, Plan, Stats))
+			{
+				Planner.Reservations.ReservePath(Plan.Steps, AgentID);
+
+				// Parked on the Target for the Rest of the Window
+				for (int32 Turn = Plan.Steps.Num(); Turn <= WindowSize; Turn++)
+				{
+					Planner.Reservations.ReserveNode(Agent.TargetID, Turn, AgentID);
+				}
+				continue;
+			}
+
+			// Agents before it took every Way out. It still stands on its Start, so plan again with it first,
+			// or with it waiting if it failed in Front before
+			if (MovedToFront[AgentID])
+			{
+				Waiting[AgentID] = true;
+			}
+			else
+			{
+				MovedToFront[AgentID] = true;
+				Order.RemoveAt(OrderIndex);
+				Order.Insert(AgentID, 0);
+			}
+			BYTES_TRACE_INSTANT("AgentReplan");
+			bPlanned = false;
+			break;
+		}
+	}
+
+	int32 NumBlocked = 0;
+	for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+	{
+		FBytesAgentPlan& Plan = OutPlans[AgentID];
+		if (Waiting[AgentID])
+		{
+			const int32 StartCost = Graph.TargetCostCache.FindOrBuild(Graph, Agents[AgentID].TargetID)[Agents[AgentID].StartID];
+			Plan = FBytesAgentPlan();
+			Plan.Steps = {Agents[AgentID].StartID};
+			Plan.bBlocked = true;
+			Plan.EstimatedCost = StartCost == INITIAL_DISTANCE ? INITIAL_DISTANCE : int64(StartCost) + int64(WaitCost) * WindowSize;
+		}
+		NumBlocked += Plan.bBlocked;
+	}
+	return NumBlocked;
+}
+
+bool UBytesMultiAgent::PlanOptimalPaths(FBytesGraph& Graph, FBytesConflictSolver& Solver, const TArray<FBytesAgentRequest>& Agents, TArray<FBytesAgentPlan>& OutPlans)
+{
+	BYTES_TRACE_SCOPE("PlanOptimalPaths");
+
+	// Every Agent waits on its Start unless Plans without Conflicts are found
+	OutPlans.Reset();
+	for (const FBytesAgentRequest& Agent : Agents)
+	{
+		FBytesAgentPlan& Plan = OutPlans.AddDefaulted_GetRef();
+		Plan.Steps = {Agent.StartID};
+		Plan.bBlocked = true;
+	}
+	Solver.LastStats = FBytesSearchStats();
+	Solver.LastConstraintNodes = 0;
+	Solver.LastSearches = 0;
+	Solver.LastReusedSearches = 0;
+#if BYTES_PATHFINDER_STATS
+	FBytesSearchStats* Stats = &Solver.LastStats;
+#else
+	FBytesSearchStats* Stats = nullptr;
+#endif
+
+	TSet<int32> Starts;
+	TSet<int32> Targets;
+	for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+	{
+		const FBytesAgentRequest& Agent = Agents[AgentID];
+		if (!Graph.IsValidNode(Agent.StartID) || !Graph.IsValidNode(Agent.TargetID))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's for Agent %d. Out of Range"), AgentID);
+			return false;
+		}
+
+		// Two Agents can not stay on one Target, the Tree would grow until it runs out of Nodes
+		bool bStartTaken = false;
+		bool bTargetTaken = false;
+		Starts.Add(Agent.StartID, &bStartTaken);
+		Targets.Add(Agent.TargetID, &bTargetTaken);
+		if (bStartTaken || bTargetTaken)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Agent %d shares its Start or Target with another Agent"), AgentID);
+			return false;
+		}
+	}
+
+	const int32 WaitCost = FMath::Max(Solver.WaitCost, 1);
+	Graph.TargetCostCache.Trim(Agents.Num());
+
+	// Single Agent Searches, shared by every Constraint Node whose Agent has the same Constraints
+	TArray<FAgentSearch> Searches;
+	TMap<FConstraintSetKey, int32> SearchIndices;
+	const auto FindOrPlan = [&](FConstraintSetKey&& Key)
+	{
+		Key.Constraints.Sort();
+		if (Solver.bReuseSearches)
+		{
+			if (const int32* SearchIndex = SearchIndices.Find(Key))
+			{
+				Solver.LastReusedSearches++;
+				return *SearchIndex;
+			}
+		}
+
+		Solver.LastSearches++;
+		const FBytesAgentRequest& Agent = Agents[Key.AgentID];
+		const int32 SearchIndex = Searches.Add(PlanConstrainedAgent(Graph, Graph.TargetCostCache.FindOrBuild(Graph, Agent.TargetID), Agent, Key.Constraints, WaitCost, Graph.SparseSearchState, Stats));
+		if (Solver.bReuseSearches)
+		{
+			SearchIndices.Add(MoveTemp(Key), SearchIndex);
+		}
+		return SearchIndex;
+	};
+
+	TArray<FConstraintNode> Nodes;
+	TArray<FConstraintEntry> OpenSet;
+
+	// Sums the Costs and counts the Conflicts of a Node whose Searches are set
+	const auto PushNode = [&](FConstraintNode&& Node)
+	{
+		TArray<const TArray<int32>*> Steps;
+		for (const int32 SearchIndex : Node.SearchIndices)
+		{
+			Node.Cost += Searches[SearchIndex].Cost;
+			Steps.Add(&Searches[SearchIndex].Steps);
+		}
+		Node.NumConflicts = FindConflicts(Steps, nullptr);
+		OpenSet.HeapPush({Node.Cost, Node.NumConflicts, Nodes.Num()}, FConstraintEntry::HasHigherPriority);
+		Nodes.Add(MoveTemp(Node));
+	};
+
+	// ==== Sub Section | Root ==== //
+	// Every Agent alone, a Target that can not be reached ends the Search
+	{
+		FConstraintNode Root;
+		for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+		{
+			const int32 SearchIndex = FindOrPlan({AgentID, {}});
+			if (Searches[SearchIndex].Cost == INDEX_NONE)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Agent %d can not reach its Target"), AgentID);
+				return false;
+			}
+			Root.SearchIndices.Add(SearchIndex);
+		}
+		PushNode(MoveTemp(Root));
+	}
+
+	// ==== Sub Section | Constraint Tree ==== //
+	while (!OpenSet.IsEmpty() && Solver.LastConstraintNodes < Solver.MaxConstraintNodes)
+	{
+		FConstraintEntry Entry;
+		OpenSet.HeapPop(Entry, FConstraintEntry::HasHigherPriority);
+		Solver.LastConstraintNodes++;
+
+		if (Nodes[Entry.NodeIndex].NumConflicts == 0)
+		{
+			for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+			{
+				const FAgentSearch& Search = Searches[Nodes[Entry.NodeIndex].SearchIndices[AgentID]];
+				FBytesAgentPlan& Plan = OutPlans[AgentID];
+				Plan.Steps = Search.Steps;
+				Plan.bReachesTarget = true;
+				Plan.bBlocked = false;
+				Plan.EstimatedCost = Search.Cost;
+			}
+			return true;
+		}
+
+		// Conflicts are found again instead of kept, most Nodes never get expanded
+		TArray<FAgentConflict> Conflicts;
+		{
+			TArray<const TArray<int32>*> Steps;
+			for (const int32 SearchIndex : Nodes[Entry.NodeIndex].SearchIndices)
+			{
+				Steps.Add(&Searches[SearchIndex].Steps);
+			}
+			FindConflicts(Steps, &Conflicts);
+		}
+
+		// Constraints of every Agent from the Root down to this Node
+		TMap<int32, TArray<FAgentConstraint>> AgentConstraints;
+		for (int32 NodeIndex = Entry.NodeIndex; Nodes[NodeIndex].ParentIndex != INDEX_NONE; NodeIndex = Nodes[NodeIndex].ParentIndex)
+		{
+			AgentConstraints.FindOrAdd(Nodes[NodeIndex].Constraint.AgentID).Add(Nodes[NodeIndex].Constraint);
+		}
+
+		// Each Child forbids one Agent of the Conflict its Part of it
+		const auto MakeConstraint = [](const FAgentConflict& Conflict, const bool bFirstAgent)
+		{
+			FAgentConstraint Constraint;
+			Constraint.AgentID = bFirstAgent ? Conflict.AgentA : Conflict.AgentB;
+			Constraint.Time = Conflict.Time;
+			Constraint.NodeID = Conflict.bSwap && !bFirstAgent ? Conflict.NodeB : Conflict.NodeA;
+			Constraint.FromID = !Conflict.bSwap ? INDEX_NONE : bFirstAgent ? Conflict.NodeB : Conflict.NodeA;
+			return Constraint;
+		};
+
+		/*
+		 * Both Children of every Conflict get planned, their Searches are needed for the Branch anyway.
+		 * Branches on the Conflict that raises the Cost of both Children (cardinal), else of one, else the earliest.
+		 * Cardinal Conflicts raise the Cost of the whole Subtree, which keeps the Tree narrow.
+		 */
+		int32 BestConflict = INDEX_NONE;
+		int32 BestRank = INDEX_NONE;
+		int32 BestSearchIndices[2] = {INDEX_NONE, INDEX_NONE};
+		for (int32 ConflictIndex = 0; ConflictIndex < Conflicts.Num() && BestRank < 2; ConflictIndex++)
+		{
+			int32 SearchIndices[2];
+			int32 Rank = 0;
+			for (const bool bFirstAgent : {true, false})
+			{
+				const FAgentConstraint Constraint = MakeConstraint(Conflicts[ConflictIndex], bFirstAgent);
+				FConstraintSetKey Key{Constraint.AgentID, {Constraint}};
+				if (const TArray<FAgentConstraint>* Constraints = AgentConstraints.Find(Constraint.AgentID))
+				{
+					Key.Constraints.Append(*Constraints);
+				}
+
+				const int32 SearchIndex = FindOrPlan(MoveTemp(Key));
+				const int64 ChildCost = Searches[SearchIndex].Cost;
+				Rank += ChildCost == INDEX_NONE || ChildCost > Searches[Nodes[Entry.NodeIndex].SearchIndices[Constraint.AgentID]].Cost;
+				SearchIndices[bFirstAgent ? 0 : 1] = SearchIndex;
+			}
+
+			if (Rank > BestRank || Rank == BestRank && Conflicts[ConflictIndex].Time < Conflicts[BestConflict].Time)
+			{
+				BestConflict = ConflictIndex;
+				BestRank = Rank;
+				BestSearchIndices[0] = SearchIndices[0];
+				BestSearchIndices[1] = SearchIndices[1];
+			}
+		}
+
+		for (const bool bFirstAgent : {true, false})
+		{
+			const int32 SearchIndex = BestSearchIndices[bFirstAgent ? 0 : 1];
+			if (Searches[SearchIndex].Cost == INDEX_NONE)
+			{
+				continue;
+			}
+
+			FConstraintNode Child;
+			Child.ParentIndex = Entry.NodeIndex;
+			Child.Constraint = MakeConstraint(Conflicts[BestConflict], bFirstAgent);
+			Child.SearchIndices = Nodes[Entry.NodeIndex].SearchIndices;
+			Child.SearchIndices[Child.Constraint.AgentID] = SearchIndex;
+			PushNode(MoveTemp(Child));
+		}
+	}
+
+	UE_LOG(LogTemp, Warning, TEXT("Pathfinding: No Plans without Conflicts after %d Constraint Nodes"), Solver.LastConstraintNodes);
+	return false;
+}
+
+int32 UBytesMultiAgent::CountConflicts(const TArray<FBytesAgentPlan>& Plans)
+{
+	TArray<const TArray<int32>*> Steps;
+	for (const FBytesAgentPlan& Plan : Plans)
+	{
+		Steps.Add(&Plan.Steps);
+	}
+	return FindConflicts(Steps, nullptr);
+}
@@ -0,0 +1,247 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Pathfinding/BytesPathfinder.h"
+#include "BytesMultiAgent.generated.h"
+
+// ==== Section | Reservation Table ==== //
+
+// One Node in one Turn
+struct FBytesSpaceTimeKey
+{
+	int32 NodeID = INDEX_NONE;
+	int32 Time = 0;
+
+	bool operator==(const FBytesSpaceTimeKey& Other) const
+	{
+		return NodeID == Other.NodeID && Time == Other.Time;
+	}
+
+	friend uint32 GetTypeHash(const FBytesSpaceTimeKey& Key)
+	{
+		return HashCombineFast(GetTypeHash(Key.NodeID), GetTypeHash(Key.Time));
+	}
+};
+
+// One Step over an Edge that arrives in Turn Time
+struct FBytesSpaceTimeMove
+{
+	int32 FromID = INDEX_NONE;
+	int32 ToID = INDEX_NONE;
+	int32 Time = 0;
+
+	bool operator==(const FBytesSpaceTimeMove& Other) const
+	{
+		return FromID == Other.FromID && ToID == Other.ToID && Time == Other.Time;
+	}
+
+	friend uint32 GetTypeHash(const FBytesSpaceTimeMove& Move)
+	{
+		return HashCombineFast(HashCombineFast(GetTypeHash(Move.FromID), GetTypeHash(Move.ToID)), GetTypeHash(Move.Time));
+	}
+};
+
+/*
+ * Which Agent stands on which Node in which Turn, and which Edges are crossed in which Turn.
+ * Two Agents may never stand on the same Node in the same Turn, or swap their Nodes over one Edge.
+ * Following an Agent onto the Node it leaves in the same Turn is allowed.
+ */
+class BYTESHEXGRIDPLUGIN_API FBytesReservationTable
+{
+public:
+	void Reset()
+	{
+		Nodes.Reset();
+		Moves.Reset();
+	}
+
+	// -1 if no Agent stands there
+	int32 GetAgentAt(const int32 NodeID, const int32 Time) const
+	{
+		const int32* AgentID = Nodes.Find({NodeID, Time});
+		return AgentID ? *AgentID : INDEX_NONE;
+	}
+
+	bool IsNodeFree(const int32 NodeID, const int32 Time, const int32 AgentID) const
+	{
+		const int32 Owner = GetAgentAt(NodeID, Time);
+		return Owner == INDEX_NONE || Owner == AgentID;
+	}
+
+	// False if another Agent comes the other Way over the same Edge in the same Turn
+	bool IsMoveFree(const int32 FromID, const int32 ToID, const int32 Time, const int32 AgentID) const
+	{
+		const int32* Owner = Moves.Find({ToID, FromID, Time});
+		return Owner == nullptr || *Owner == AgentID;
+	}
+
+	void ReserveNode(const int32 NodeID, const int32 Time, const int32 AgentID)
+	{
+		Nodes.Add({NodeID, Time}, AgentID);
+	}
+
+	void ReserveMove(const int32 FromID, const int32 ToID, const int32 Time, const int32 AgentID)
+	{
+		Moves.Add({FromID, ToID, Time}, AgentID);
+	}
+
+	// Steps[Turn] is the Node of the Agent in that Turn, Steps[0] its Start
+	void ReservePath(const TArray<int32>& Steps, const int32 AgentID);
+
+	int32 Num() const
+	{
+		return Nodes.Num();
+	}
+
+private:
+	TMap<FBytesSpaceTimeKey, int32> Nodes;
+	TMap<FBytesSpaceTimeMove, int32> Moves;
+};
+
+// ==== Section | Cooperative Pathfinding ==== //
+
+// Start and Target of one Agent for "UBytesMultiAgent::PlanCooperativePaths()"
+USTRUCT(BlueprintType)
+struct FBytesAgentRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "Pathfinder|Multi Agent")
+	int32 StartID = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Pathfinder|Multi Agent")
+	int32 TargetID = INDEX_NONE;
+};
+
+USTRUCT(BlueprintType)
+struct FBytesAgentPlan
+{
+	GENERATED_BODY()
+
+	// Node of the Agent in every Turn, Steps[0] is its Start. Waiting repeats the Node. Ends at the Window or on the Target
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Multi Agent")
+	TArray<int32> Steps;
+
+	// The Steps end on the Target and the Agent can stay there until the Window ends
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Multi Agent")
+	bool bReachesTarget = false;
+
+	// The Target can not be reached, or no Steps fit around the other Agents even when planned first.
+	// The Agent waits on its Start for the whole Window and every other Agent plans around it
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Multi Agent")
+	bool bBlocked = false;
+
+	// Cost of the Steps, Waits included, plus the Cost from the last Step to the Target
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Multi Agent")
+	int64 EstimatedCost = 0;
+};
+
+/*
+ * Settings and reusable Memory of "UBytesMultiAgent::PlanCooperativePaths()", pass the same one every Turn.
+ * The Cost to every Target from every Node is computed once and kept by the Graph until it changes.
+ */
+USTRUCT(BlueprintType)
+struct BYTESHEXGRIDPLUGIN_API FBytesCooperativePlanner
+{
+	GENERATED_BODY()
+
+	// Turns every Agent plans ahead. Beyond the Window only the Cost to the Target counts
+	UPROPERTY(BlueprintReadWrite, Category = "Pathfinder|Multi Agent")
+	int32 WindowSize = 8;
+
+	// Cost of waiting one Turn on a Node, same as one Step on the Debug Grids
+	UPROPERTY(BlueprintReadWrite, Category = "Pathfinder|Multi Agent")
+	int32 WaitCost = 100;
+
+	// Summed over all Agents of the last Plan, only filled if BYTES_PATHFINDER_STATS is enabled.
+	// Expanded Nodes count (Node, Turn) Pairs
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Multi Agent")
+	FBytesSearchStats LastStats;
+
+	// Not serialized, Reservations of the last Plan
+	FBytesReservationTable Reservations;
+};
+
+// Settings and Counters of "UBytesMultiAgent::PlanOptimalPaths()"
+USTRUCT(BlueprintType)
+struct BYTESHEXGRIDPLUGIN_API FBytesConflictSolver
+{
+	GENERATED_BODY()
+
+	// Cost of waiting one Turn on a Node, at least 1. Free Waiting would give endless Branches of the same Cost.
+	// Waiting on the Target after the last Arrival is free
+	UPROPERTY(BlueprintReadWrite, Category = "Pathfinder|Multi Agent")
+	int32 WaitCost = 100;
+
+	// Constraint Tree Nodes the Solver may expand before it gives up. The Tree grows exponentially with the Conflicts
+	UPROPERTY(BlueprintReadWrite, Category = "Pathfinder|Multi Agent")
+	int32 MaxConstraintNodes = 4096;
+
+	// Single Agent Searches are kept per Agent and Set of Constraints, Branches that end up with the same Set share them
+	UPROPERTY(BlueprintReadWrite, Category = "Pathfinder|Multi Agent")
+	bool bReuseSearches = true;
+
+	// Summed over all Single Agent Searches of the last Call, only filled if BYTES_PATHFINDER_STATS is enabled
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Multi Agent")
+	FBytesSearchStats LastStats;
+
+	// Constraint Tree Nodes expanded by the last Call
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Multi Agent")
+	int32 LastConstraintNodes = 0;
+
+	// Single Agent Searches run by the last Call
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Multi Agent")
+	int32 LastSearches = 0;
+
+	// Single Agent Searches the last Call took from earlier Branches instead of running them
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Multi Agent")
+	int32 LastReusedSearches = 0;
+};
+
+// ==== Section | Multi Agent BP Function Library ==== //
+UCLASS()
+class BYTESHEXGRIDPLUGIN_API UBytesMultiAgent : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/*
+	 * Windowed Hierarchical Cooperative A* (WHCA*, see https://www.davidsilver.uk/wp-content/uploads/2020/03/coop-path-AIWisdom.pdf).
+	 * Agents plan one after another in Array Order and reserve their Steps in the Reservation Table, later Agents plan around them.
+	 * Every Agent searches over (Node, Turn) Pairs for WindowSize Turns, each Turn it steps over one Edge or waits.
+	 * The Heuristic is the true Cost to the Target from a backwards Dijkstra, so Agents keep heading for it beyond the Window.
+	 * The Searches run on the sparse Search State of the Graph, see "FBytesGraph::SparseSearchState".
+	 * An Agent boxed in by the Agents before it moves to the Front and all Agents plan again. If it fails there too it is blocked.
+	 * The Plans never conflict, "CountConflicts(OutPlans)" is always 0.
+	 *
+	 * Typical Turn: move every Agent by the first Step of its Plan, then plan again from the new Starts.
+	 * Starts have to be distinct. Rotating the Order between Turns spreads the Waiting among the Agents.
+	 * Returns the Number of blocked Agents.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Multi Agent")
+	static int32 PlanCooperativePaths(UPARAM(ref) FBytesGraph& Graph, UPARAM(ref) FBytesCooperativePlanner& Planner, const TArray<FBytesAgentRequest>& Agents, TArray<FBytesAgentPlan>& OutPlans);
+
+	/*
+	 * Conflict Based Search (CBS, see https://doi.org/10.1016/j.artint.2014.11.006), optimal for small Maps and up to ~20 Agents.
+	 * Plans every Agent alone, then resolves a Conflict of two Agents by branching: in one Branch the first Agent may not
+	 * be on that Node (or cross that Edge) in that Turn, in the other the second Agent. Only the constrained Agent plans again.
+	 * Conflicts whose Branches both cost more are resolved first. The Constraint Tree is expanded cheapest first,
+	 * so the first Set of Plans without Conflicts has the lowest Sum of Costs.
+	 *
+	 * Every Plan ends on its Target and the Agent stays there. Starts and Targets have to be distinct.
+	 * Single Agent Searches run on the sparse Search State of the Graph, like in "PlanCooperativePaths()".
+	 * Returns false if a Target can not be reached or no Plans were found within "MaxConstraintNodes", every Agent is blocked then.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Multi Agent")
+	static bool PlanOptimalPaths(UPARAM(ref) FBytesGraph& Graph, UPARAM(ref) FBytesConflictSolver& Solver, const TArray<FBytesAgentRequest>& Agents, TArray<FBytesAgentPlan>& OutPlans);
+
+	/*
+	 * Pairs of Plans that meet on a Node in the same Turn or swap their Nodes over an Edge.
+	 * Agents stay on the last Node of their Steps, Plans without Steps are skipped.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Multi Agent")
+	static int32 CountConflicts(const TArray<FBytesAgentPlan>& Plans);
+};
@@ -1,333 +1,1340 @@
 ﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
 
 #include "Pathfinding/BytesPathfinder.h"
+#include "Pathfinding/BytesPathfinderSearch.h"
+#include "Pathfinding/BytesGraphFile.h"
+#include "Pathfinding/BytesPathfinderTrace.h"
+#include "Hash/CityHash.h"
+#include "Misc/ScopeLock.h"
 
-constexpr int32 INITIAL_DISTANCE = 2000000;
+namespace
+{
+	// Shared by every Graph, Searches may run on several Threads at once
+	FCriticalSection SearchTelemetryLock;
+	FBytesSearchTelemetry SearchTelemetry;
+
+	// Stats Target for the Search Templates, nullptr if Stats are compiled out
+	FBytesSearchStats* BeginSearchStats(FBytesGraph& Graph)
+	{
+		Graph.LastSearchStats = FBytesSearchStats();
+#if BYTES_PATHFINDER_STATS
+		return &Graph.LastSearchStats;
+#else
+		return nullptr;
+#endif
+	}
+
+	template<typename QueueType, typename GraphType>
+	bool RunPathSearch(const FBytesGraph& Graph, const GraphType& Accessor, FBytesSearchState& State, const int32 StartID, const int32 TargetID, FBytesSearchStats* Stats)
+	{
+		switch (Graph.PathMode)
+		{
+		case EBytesPathMode::AnyAngle:
+			return BytesSearch::ThetaStar<FBytesGraphLineOfSight, QueueType>(Accessor, State, StartID, TargetID, Stats);
+		case EBytesPathMode::LazyAnyAngle:
+			return BytesSearch::LazyThetaStar<FBytesGraphLineOfSight, QueueType>(Accessor, State, StartID, TargetID, Stats);
+		default:
+			if (Graph.HeuristicWeight > 1.0)
+			{
+				return BytesSearch::WeightedAStar<QueueType>(Accessor, State, StartID, TargetID, Graph.HeuristicWeight, Stats);
+			}
+			return BytesSearch::AStar<QueueType>(Accessor, State, StartID, TargetID, Stats);
+		}
+	}
+
+	// Instantiates the Search Templates for the Open List and Path Mode the Graph asks for, so every Combination gets its own inlined Loop
+	template<typename GraphType>
+	bool RunAStar(const FBytesGraph& Graph, const GraphType& Accessor, FBytesSearchState& State, const int32 StartID, const int32 TargetID, FBytesSearchStats* Stats)
+	{
+		if (Graph.SearchQueue == EBytesSearchQueue::LazyHeap)
+		{
+			return RunPathSearch<FBytesLazyQueue>(Graph, Accessor, State, StartID, TargetID, Stats);
+		}
+		return RunPathSearch<FBytesIndexedQueue>(Graph, Accessor, State, StartID, TargetID, Stats);
+	}
+
+	// A* into the sparse State, it only works with the lazy Heap
+	template<typename GraphType>
+	bool RunSparseAStar(const FBytesGraph& Graph, const GraphType& Accessor, FBytesSparseSearchState& State, const int32 StartID, const int32 TargetID, FBytesSearchStats* Stats)
+	{
+		if (Graph.HeuristicWeight > 1.0)
+		{
+			return BytesSearch::WeightedAStar<FBytesSparseLazyQueue>(Accessor, State, StartID, TargetID, Graph.HeuristicWeight, Stats);
+		}
+		return BytesSearch::AStar<FBytesSparseLazyQueue>(Accessor, State, StartID, TargetID, Stats);
+	}
+
+	// The sparse State costs a few Times more per reached Node, the dense one Setup for every Node of the Graph
+	constexpr double SparseSearchNodeFraction = 1.0 / 16.0;
+
+	bool ShouldSearchSparse(const FBytesGraph& Graph, const int32 StartID, const int32 TargetID)
+	{
+		// Any Angle Searches keep their own Lists over every Node
+		if (Graph.PathMode != EBytesPathMode::GraphEdges || Graph.SearchMemory == EBytesSearchMemory::Dense)
+		{
+			return false;
+		}
+		if (Graph.SearchMemory == EBytesSearchMemory::Sparse)
+		{
+			return true;
+		}
+
+		// The mean Edge Length around Start stands in for the Spacing of the Nodes. Edges to tombstoned Nodes are never followed
+		const FVector2D StartLocation = Graph.Nodes[StartID].Location2D;
+		int32 NumEdges = 0;
+		double EdgeLength = 0.0;
+		for (const FBytesEdge& Edge : Graph.Edges[StartID].NeighbouringEdges)
+		{
+			if (!Graph.Nodes[Edge.NodeID].bRemoved)
+			{
+				NumEdges++;
+				EdgeLength += FVector2D::Distance(StartLocation, Graph.Nodes[Edge.NodeID].Location2D);
+			}
+		}
+		if (EdgeLength <= 0.0)
+		{
+			return false;
+		}
+
+		// Nodes on a Disk with the Distance to the Target as Radius, more than A* usually reaches. Compared to the live Nodes only
+		const double Radius = FVector2D::Distance(StartLocation, Graph.Nodes[TargetID].Location2D) * NumEdges / EdgeLength;
+		return UE_PI * Radius * Radius < (Graph.Nodes.Num() - Graph.NumRemovedNodes) * SparseSearchNodeFraction;
+	}
+
+	template<typename GraphType>
+	void RunDijkstra(const FBytesGraph& Graph, const GraphType& Accessor, FBytesSearchState& State, const int32 StartID, FBytesSearchStats* Stats)
+	{
+		if (Graph.SearchQueue == EBytesSearchQueue::LazyHeap)
+		{
+			BytesSearch::Dijkstra<FBytesLazyQueue>(Accessor, State, StartID, Stats);
+			return;
+		}
+		BytesSearch::Dijkstra<FBytesIndexedQueue>(Accessor, State, StartID, Stats);
+	}
+
+	template<typename GraphType>
+	void SimplifyPathInPlace(const GraphType& Accessor, const int32 StartID, TArray<int32>& Path, const EBytesPathSimplification Simplification)
+	{
+		switch (Simplification)
+		{
+		case EBytesPathSimplification::RemoveCollinear:
+			BytesSearch::RemoveCollinearNodes(Accessor, StartID, Path);
+			break;
+		case EBytesPathSimplification::PullString:
+			BytesSearch::PullString(Accessor, FBytesGraphLineOfSight(), StartID, Path);
+			break;
+		default:
+			break;
+		}
+	}
+
+	int32 GetHistogramBucket(const int64 Value)
+	{
+		return Value <= 0 ? 0 : FMath::Min<int32>(FMath::FloorLog2_64(Value) + 1, FBytesSearchTelemetry::NumBuckets - 1);
+	}
+}
+
+void FBytesSparseSearchState::Init(const int32 NumNodes, const int32 InitialCost)
+{
+	// Sized for the last Search, so one large Search does not leave every following small one a large Table to clear
+	const int32 NumBuckets = FMath::Max<int32>(MinBuckets, FMath::RoundUpToPowerOfTwo(uint32(NumSlots) * 2));
+	Buckets.Init({INDEX_NONE, INDEX_NONE}, NumBuckets);
+	BucketShift = 32 - FMath::FloorLog2(uint32(NumBuckets));
+	NumSlots = 0;
+	DefaultSlot.GCost = InitialCost;
+}
+
+void FBytesSparseSearchState::Reset()
+{
+	Buckets.Empty();
+	BucketShift = 32;
+	Pages.Empty();
+	NumSlots = 0;
+}
+
+void FBytesSparseSearchState::SetNumBuckets(const int32 NumBuckets)
+{
+	const TArray<FBucket> OldBuckets = MoveTemp(Buckets);
+	Buckets.Init({INDEX_NONE, INDEX_NONE}, NumBuckets);
+	BucketShift = 32 - FMath::FloorLog2(uint32(NumBuckets));
+
+	const uint32 Mask = NumBuckets - 1;
+	for (const FBucket& Bucket : OldBuckets)
+	{
+		if (Bucket.NodeID == INDEX_NONE)
+		{
+			continue;
+		}
+
+		uint32 Index = GetHomeBucket(Bucket.NodeID);
+		while (Buckets[Index].NodeID != INDEX_NONE)
+		{
+			Index = (Index + 1) & Mask;
+		}
+		Buckets[Index] = Bucket;
+	}
+}
+
+uint64 FBytesCostProfile::GetHash() const
+{
+	// 0 is reserved for Queries without Profile
+	const uint64 Hash = CityHash64(reinterpret_cast<const char*>(TerrainCostPercent.GetData()), TerrainCostPercent.Num() * sizeof(int32));
+	return Hash != 0 ? Hash : 1;
+}
+
+void FBytesPathCache::SetCapacity(const int32 Capacity)
+{
+	if (Capacity <= 0)
+	{
+		Entries.Reset();
+		return;
+	}
+	Entries = MakeUnique<TLruCache<FBytesPathCacheKey, FEntry>>(Capacity);
+}
+
+const TArray<int32>* FBytesPathCache::Find(const FBytesPathCacheKey& Key, const uint32 GraphVersion)
+{
+	if (!Entries)
+	{
+		return nullptr;
+	}
+
+	const FEntry* Entry = Entries->FindAndTouch(Key);
+	if (Entry && Entry->GraphVersion == GraphVersion)
+	{
+		Stats.Hits++;
+		return &Entry->Path;
+	}
+
+	// Stale Entries would only take the Place of valid ones
+	if (Entry)
+	{
+		Entries->Remove(Key);
+		Stats.Invalidations++;
+	}
+	Stats.Misses++;
+	return nullptr;
+}
+
+void FBytesPathCache::Add(const FBytesPathCacheKey& Key, const uint32 GraphVersion, const TArray<int32>& Path)
+{
+	if (!Entries)
+	{
+		return;
+	}
+
+	// Adding to a full Cache drops the least recently used Entry
+	if (Entries->Num() == Entries->Max() && !Entries->Contains(Key))
+	{
+		Stats.Evictions++;
+	}
+	Entries->Add(Key, {GraphVersion, Path});
+}
+
+const FBytesShortestPathTree* FBytesTreeCache::Find(const int32 SourceID, const uint32 GraphVersion, const int32 NumNodes)
+{
+	const int32 Index = Trees.IndexOfByPredicate([SourceID](const FBytesShortestPathTree& Tree)
+	{
+		return Tree.SourceID == SourceID;
+	});
+
+	if (Index == INDEX_NONE)
+	{
+		Stats.Misses++;
+		return nullptr;
+	}
+
+	// Added Nodes do not bump the Version, but the Tree does not know them
+	FBytesShortestPathTree& Tree = Trees[Index];
+	if (Tree.GraphVersion != GraphVersion || Tree.Distance.Num() != NumNodes)
+	{
+		Trees.RemoveAtSwap(Index, 1, false);
+		Stats.Invalidations++;
+		Stats.Misses++;
+		return nullptr;
+	}
+
+	Stats.Hits++;
+	Tree.LastUsed = ++Tick;
+	return &Tree;
+}
+
+const FBytesShortestPathTree& FBytesTreeCache::Add(FBytesShortestPathTree&& Tree)
+{
+	Tree.LastUsed = ++Tick;
+
+	// Evict the least recently used Trees until the new one fits
+	int64 UsedBytes = Tree.GetAllocatedSize();
+	for (const FBytesShortestPathTree& Other : Trees)
+	{
+		UsedBytes += Other.GetAllocatedSize();
+	}
+
+	while (UsedBytes > MaxBytes && !Trees.IsEmpty())
+	{
+		int32 OldestIndex = 0;
+		for (int32 Index = 1; Index < Trees.Num(); Index++)
+		{
+			if (Trees[Index].LastUsed < Trees[OldestIndex].LastUsed)
+			{
+				OldestIndex = Index;
+			}
+		}
+
+		UsedBytes -= Trees[OldestIndex].GetAllocatedSize();
+		Trees.RemoveAtSwap(OldestIndex, 1, false);
+		Stats.Evictions++;
+	}
+
+	return Trees.Add_GetRef(MoveTemp(Tree));
+}
+
+const TArray<int32>& FBytesTargetCostCache::FindOrBuild(const FBytesGraph& Graph, const int32 TargetID)
+{
+	// Added Nodes do not bump the Version, but the Tables do not know them
+	if (GraphVersion != Graph.Version || NumNodes != Graph.Nodes.Num())
+	{
+		Costs.Reset();
+		GraphVersion = Graph.Version;
+		NumNodes = Graph.Nodes.Num();
+	}
+
+	if (const TArray<int32>* TargetCosts = Costs.Find(TargetID))
+	{
+		return *TargetCosts;
+	}
+
+	// Backwards, so directed Edges count in the Direction the Agent walks them
+	FBytesSearchState State;
+	const FBytesGraphAccessor Accessor(Graph);
+	BytesSearch::Dijkstra(TBytesReversedGraph<FBytesGraphAccessor>(Accessor), State, TargetID);
+	return Costs.Add(TargetID, MoveTemp(State.GCost));
+}
+
+void FBytesTargetCostCache::Trim(const int32 NumInUse)
+{
+	// Targets are usually the same for many Turns, so only a Cache far beyond them starts over
+	constexpr int32 MaxUnusedTargets = 64;
+	if (Costs.Num() > NumInUse + MaxUnusedTargets)
+	{
+		Costs.Reset();
+	}
+}
+
+void FBytesSearchTelemetry::Record(const FBytesSearchStats& Stats)
+{
+	if (NodesExpandedHistogram.IsEmpty())
+	{
+		NodesExpandedHistogram.Init(0, NumBuckets);
+		WallTimeHistogram.Init(0, NumBuckets);
+	}
+
+	NumSearches++;
+	Totals += Stats;
+	NodesExpandedHistogram[GetHistogramBucket(Stats.NodesExpanded)]++;
+	WallTimeHistogram[GetHistogramBucket(int64(Stats.WallTimeSeconds * 1000000.0))]++;
+}
+
+int64 FBytesSearchTelemetry::GetPercentile(const TArray<int64>& Histogram, const double Percentile)
+{
+	int64 Total = 0;
+	for (const int64 Count : Histogram)
+	{
+		Total += Count;
+	}
+
+	// Walk the Buckets until enough Values are below
+	const int64 Rank = FMath::CeilToInt64(FMath::Clamp(Percentile, 0.0, 1.0) * Total);
+	int64 Seen = 0;
+	for (int32 Bucket = 0; Bucket < Histogram.Num(); Bucket++)
+	{
+		Seen += Histogram[Bucket];
+		if (Seen >= Rank && Seen > 0)
+		{
+			return Bucket == 0 ? 1 : int64(1) << Bucket;
+		}
+	}
+	return 0;
+}
+
+void UBytesPathfinder::FindPathsToNodes(FBytesGraph& Graph, const int32 StartID)
+{
+	BYTES_TRACE_SCOPE_NODES("FindPathsToNodes", StartID, INDEX_NONE);
+	RunDijkstra(Graph, FBytesGraphAccessor(Graph), Graph.SearchState, StartID, BeginSearchStats(Graph));
+	RecordSearch(Graph);
+}
+
+void UBytesPathfinder::FindPath(FBytesGraph& Graph, const int32 StartID, const int32 TargetID)
+{
+	BYTES_TRACE_SCOPE_NODES("FindPath", StartID, TargetID);
+
+	// No Logging here, this runs for every Query. Failed Searches show up in the Trace instead
+	if (!RunAStar(Graph, FBytesGraphAccessor(Graph), Graph.SearchState, StartID, TargetID, BeginSearchStats(Graph)))
+	{
+		BYTES_TRACE_INSTANT("NoPathFound");
+	}
+	RecordSearch(Graph);
+}
+
+void UBytesPathfinder::FindPathsToNodesWithProfile(FBytesGraph& Graph, const int32 StartID, const FBytesCostProfile& Profile)
+{
+	BYTES_TRACE_SCOPE_NODES("FindPathsToNodesWithProfile", StartID, INDEX_NONE);
+	const FBytesGraphAccessor Accessor(Graph);
+	RunDijkstra(Graph, TBytesProfiledGraph<FBytesGraphAccessor>(Accessor, Profile), Graph.SearchState, StartID, BeginSearchStats(Graph));
+	RecordSearch(Graph);
+}
+
+void UBytesPathfinder::FindPathsFromNodes(FBytesGraph& Graph, const int32 TargetID)
+{
+	BYTES_TRACE_SCOPE_NODES("FindPathsFromNodes", INDEX_NONE, TargetID);
+	const FBytesGraphAccessor Accessor(Graph);
+	RunDijkstra(Graph, TBytesReversedGraph<FBytesGraphAccessor>(Accessor), Graph.SearchState, TargetID, BeginSearchStats(Graph));
+	RecordSearch(Graph);
+}
+
+TArray<int32> UBytesPathfinder::GetPathToTarget(FBytesGraph& Graph, const int32 StartNodeID, const int32 TargetNodeID)
+{
+	// Check if Indices are valid
+	if (!Graph.IsValidNode(StartNodeID) || !Graph.IsValidNode(TargetNodeID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's. Out of Range"));
+		return TArray<int32>();
+	}
+
+	return BytesSearch::FollowPath(Graph.SearchState, StartNodeID, TargetNodeID);
+}
+
+TArray<int32> UBytesPathfinder::GetNodesInRange(FBytesGraph& Graph, const int32 MaxTravelCost)
+{
+	TArray<int32> ReturnArray;
+
+	const TArray<int32>& GCosts = Graph.SearchState.GCost;
+	for (int32 NodeID = 0; NodeID < GCosts.Num(); NodeID++)
+	{
+		if(GCosts[NodeID] <= MaxTravelCost && GCosts[NodeID] != INITIAL_DISTANCE) {
+			ReturnArray.Add(NodeID);
+		}
+	}
+
+	return ReturnArray;
+}
+
+TArray<int32> UBytesPathfinder::GetPath(FBytesGraph& Graph, const int32 StartNodeID, const int32 TargetNodeID, const bool bRecalculate)
+{
+	BYTES_TRACE_SCOPE_NODES("GetPath", StartNodeID, TargetNodeID);
+
+	TArray<int32> Path;
+
+	// Check if Indices are valid
+	if (!Graph.IsValidNode(StartNodeID) || !Graph.IsValidNode(TargetNodeID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's. Out of Range"));
+		return Path;
+	}
+	
+	// if we should recalculate the path, we use A*
+	// It Could be that we had a Dijkstra before and cached it, so we dont need to recalc
+	if (bRecalculate)
+	{
+		return SearchPath(Graph, StartNodeID, TargetNodeID, nullptr);
+	}
+
+	// Retrace Path from Target -> Start
+	Path = BytesSearch::RetracePath(Graph.SearchState, StartNodeID, TargetNodeID);
+
+	// Check if Target Node has ever been reached
+	if (Path.IsEmpty() && StartNodeID != TargetNodeID)
+	{
+		BYTES_TRACE_INSTANT("TargetNeverReached");
+	}
+
+	SimplifyPathInPlace(FBytesGraphAccessor(Graph), StartNodeID, Path, Graph.PathSimplification);
+	return Path;
+}
+
+TArray<int32> UBytesPathfinder::GetPathWithProfile(FBytesGraph& Graph, const int32 StartNodeID, const int32 TargetNodeID, const FBytesCostProfile& Profile)
+{
+	BYTES_TRACE_SCOPE_NODES("GetPathWithProfile", StartNodeID, TargetNodeID);
+
+	// Check if Indices are valid
+	if (!Graph.IsValidNode(StartNodeID) || !Graph.IsValidNode(TargetNodeID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's. Out of Range"));
+		return TArray<int32>();
+	}
+
+	return SearchPath(Graph, StartNodeID, TargetNodeID, &Profile);
+}
+
+bool UBytesPathfinder::AreNodesConnected(FBytesGraph& Graph, const int32 NodeAID, const int32 NodeBID)
+{
+	if (!Graph.IsValidNode(NodeAID) || !Graph.IsValidNode(NodeBID))
+	{
+		return false;
+	}
+
+	if (Graph.Components.NeedsRebuild(Graph.Nodes.Num()))
+	{
+		RebuildComponents(Graph);
+	}
+
+	return Graph.Components.Find(NodeAID) == Graph.Components.Find(NodeBID);
+}
+
+void UBytesPathfinder::SetPathCacheCapacity(FBytesGraph& Graph, const int32 Capacity)
+{
+	Graph.PathCache.SetCapacity(Capacity);
+}
+
+void UBytesPathfinder::SetSearchQueue(FBytesGraph& Graph, const EBytesSearchQueue SearchQueue)
+{
+	Graph.SearchQueue = SearchQueue;
+}
+
+void UBytesPathfinder::SetSearchMemory(FBytesGraph& Graph, const EBytesSearchMemory SearchMemory)
+{
+	Graph.SearchMemory = SearchMemory;
+	if (SearchMemory == EBytesSearchMemory::Dense)
+	{
+		Graph.SparseSearchState.Reset();
+	}
+}
+
+void UBytesPathfinder::SetPathMode(FBytesGraph& Graph, const EBytesPathMode PathMode)
+{
+	if (Graph.PathMode != PathMode)
+	{
+		Graph.PathMode = PathMode;
+		Graph.PathCache.SetCapacity(Graph.PathCache.GetCapacity());
+	}
+}
+
+void UBytesPathfinder::SetPathSimplification(FBytesGraph& Graph, const EBytesPathSimplification Simplification)
+{
+	if (Graph.PathSimplification != Simplification)
+	{
+		Graph.PathSimplification = Simplification;
+		Graph.PathCache.SetCapacity(Graph.PathCache.GetCapacity());
+	}
+}
+
+void UBytesPathfinder::SetHeuristicWeight(FBytesGraph& Graph, const double Weight)
+{
+	const double ClampedWeight = FMath::Max(Weight, 1.0);
+	if (Graph.HeuristicWeight != ClampedWeight)
+	{
+		Graph.HeuristicWeight = ClampedWeight;
+		Graph.PathCache.SetCapacity(Graph.PathCache.GetCapacity());
+	}
+}
+
+double UBytesPathfinder::FindPathAnytime(FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const double InitialWeight, const double MaxMilliseconds)
+{
+	BYTES_TRACE_SCOPE_NODES("FindPathAnytime", StartID, TargetID);
+
+	if (!Graph.IsValidNode(StartID) || !Graph.IsValidNode(TargetID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's. Out of Range"));
+		return -1.0;
+	}
+
+	if (!AreNodesConnected(Graph, StartID, TargetID))
+	{
+		BYTES_TRACE_INSTANT("TargetInOtherComponent");
+		return -1.0;
+	}
+
+	const FBytesGraphAccessor Accessor(Graph);
+	TBytesAnytimeAStar<FBytesGraphAccessor> Search(Accessor, Graph.SearchState, StartID, TargetID, InitialWeight);
+	Search.Run(MaxMilliseconds / 1000.0, BeginSearchStats(Graph));
+	RecordSearch(Graph);
+
+	if (!Search.HasPath())
+	{
+		BYTES_TRACE_INSTANT("NoPathFound");
+		return -1.0;
+	}
+	return Search.GetSuboptimalityBound();
+}
+
+TArray<int32> UBytesPathfinder::SimplifyPath(const FBytesGraph& Graph, const int32 StartNodeID, const TArray<int32>& Path, const EBytesPathSimplification Simplification)
+{
+	if (!Graph.IsValidNode(StartNodeID) || Path.ContainsByPredicate([&Graph](const int32 NodeID) { return !Graph.IsValidNode(NodeID); }))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's. Out of Range"));
+		return Path;
+	}
+
+	TArray<int32> Simplified = Path;
+	SimplifyPathInPlace(FBytesGraphAccessor(Graph), StartNodeID, Simplified, Simplification);
+	return Simplified;
+}
+
+FBytesPathCacheStats UBytesPathfinder::GetPathCacheStats(const FBytesGraph& Graph)
+{
+	return Graph.PathCache.GetStats();
+}
+
+double UBytesPathfinder::GetPathCacheHitRate(const FBytesGraph& Graph)
+{
+	return Graph.PathCache.GetStats().GetHitRate();
+}
+
+void UBytesPathfinder::SetTreeCacheBudget(FBytesGraph& Graph, const int64 MaxBytes)
+{
+	Graph.TreeCache.SetBudget(MaxBytes);
+}
+
+TArray<int32> UBytesPathfinder::GetPathFromSource(FBytesGraph& Graph, const int32 SourceID, const int32 TargetID)
+{
+	if (!Graph.IsValidNode(SourceID) || !Graph.IsValidNode(TargetID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's. Out of Range"));
+		return TArray<int32>();
+	}
+
+	return BytesSearch::RetracePath(FindOrBuildTree(Graph, SourceID).ParentID, SourceID, TargetID);
+}
+
+int32 UBytesPathfinder::GetTravelCostFromSource(FBytesGraph& Graph, const int32 SourceID, const int32 TargetID)
+{
+	if (!Graph.IsValidNode(SourceID) || !Graph.IsValidNode(TargetID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's. Out of Range"));
+		return INDEX_NONE;
+	}
+
+	const int32 Distance = FindOrBuildTree(Graph, SourceID).Distance[TargetID];
+	return Distance != INITIAL_DISTANCE ? Distance : INDEX_NONE;
+}
+
+TArray<int32> UBytesPathfinder::GetNodesInRangeFromSource(FBytesGraph& Graph, const int32 SourceID, const int32 MaxTravelCost)
+{
+	TArray<int32> ReturnArray;
+	if (!Graph.IsValidNode(SourceID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's. Out of Range"));
+		return ReturnArray;
+	}
+
+	const TArray<int32>& Distances = FindOrBuildTree(Graph, SourceID).Distance;
+	for (int32 NodeID = 0; NodeID < Distances.Num(); NodeID++)
+	{
+		if (Distances[NodeID] <= MaxTravelCost && Distances[NodeID] != INITIAL_DISTANCE)
+		{
+			ReturnArray.Add(NodeID);
+		}
+	}
+
+	return ReturnArray;
+}
+
+FBytesPathCacheStats UBytesPathfinder::GetTreeCacheStats(const FBytesGraph& Graph)
+{
+	return Graph.TreeCache.GetStats();
+}
+
+FBytesSearchStats UBytesPathfinder::GetLastSearchStats(const FBytesGraph& Graph)
+{
+	return Graph.LastSearchStats;
+}
+
+FBytesSearchTelemetry UBytesPathfinder::GetSearchTelemetry()
+{
+	FScopeLock Lock(&SearchTelemetryLock);
+	return SearchTelemetry;
+}
+
+void UBytesPathfinder::ResetSearchTelemetry()
+{
+	FScopeLock Lock(&SearchTelemetryLock);
+	SearchTelemetry = FBytesSearchTelemetry();
+}
+
+void UBytesPathfinder::LogSearchTelemetry()
+{
+	const FBytesSearchTelemetry Telemetry = GetSearchTelemetry();
+	const FBytesSearchStats& Totals = Telemetry.Totals;
+	const double SearchDivisor = FMath::Max<int64>(Telemetry.NumSearches, 1);
+
+	UE_LOG(LogTemp, Display, TEXT("Pathfinding Telemetry: %lld Searches | %.1f Expanded, %.1f Generated, %.1f Pushes, %.1f Updates per Search | Peak Open Set %lld | %.2f us per Search"),
+		Telemetry.NumSearches, Totals.NodesExpanded / SearchDivisor, Totals.NodesGenerated / SearchDivisor, Totals.HeapPushes / SearchDivisor,
+		Totals.HeapUpdates / SearchDivisor, Totals.PeakOpenSetSize, Totals.WallTimeSeconds * 1000000.0 / SearchDivisor);
+
+	UE_LOG(LogTemp, Display, TEXT("Pathfinding Telemetry: Expanded Nodes p50 < %lld, p90 < %lld, p99 < %lld | Wall Time p50 < %lld us, p90 < %lld us, p99 < %lld us"),
+		FBytesSearchTelemetry::GetPercentile(Telemetry.NodesExpandedHistogram, 0.5),
+		FBytesSearchTelemetry::GetPercentile(Telemetry.NodesExpandedHistogram, 0.9),
+		FBytesSearchTelemetry::GetPercentile(Telemetry.NodesExpandedHistogram, 0.99),
+		FBytesSearchTelemetry::GetPercentile(Telemetry.WallTimeHistogram, 0.5),
+		FBytesSearchTelemetry::GetPercentile(Telemetry.WallTimeHistogram, 0.9),
+		FBytesSearchTelemetry::GetPercentile(Telemetry.WallTimeHistogram, 0.99));
+}
+
+FBytesGraph UBytesPathfinder::CreateGraph()
+{
+	return FBytesGraph();
+}
+
+bool UBytesPathfinder::SaveGraphToFile(const FBytesGraph& Graph, const FString& FilePath)
+{
+	BYTES_TRACE_SCOPE("SaveGraphToFile");
+	return BytesGraphFile::Save(Graph, FilePath);
+}
+
+bool UBytesPathfinder::LoadGraphFromFile(const FString& FilePath, FBytesGraph& OutGraph)
+{
+	BYTES_TRACE_SCOPE("LoadGraphFromFile");
+
+	const TUniquePtr<FBytesMappedGraph> MappedGraph = FBytesMappedGraph::Open(FilePath);
+	if (!MappedGraph)
+	{
+		return false;
+	}
+
+	MappedGraph->CopyToGraph(OutGraph);
+	return true;
+}
+
+int32 UBytesPathfinder::AddNode(FBytesGraph& Graph, FVector2D Location2D)
+{
+	// ==== Sub Section | Node ==== //
+	
+	// Create new Node
+	FBytesNode NewNode;
+
+	// Set Location 2D
+	NewNode.Location2D = Location2D;
+
+	// Add Node to Graph, its NodeID is the Index
+	const int32 NewNodeID = Graph.Nodes.Add(NewNode);
+	Graph.Components.AddNode(NewNodeID);
+
+	// ==== Sub Section | Edges ==== //
+
+	// Create new Edges (Container for multiple "FBytesEdge" Structs)
+	FBytesEdges NewEdges;
+
+	// Add Edges Container, right after Node gets Created
+	Graph.Edges.Add(NewEdges);
+	if (Graph.bDirected)
+	{
+		Graph.ReverseEdges.Add(NewEdges);
+	}
+	
+	// Return ID
+	return NewNodeID;
+}
+
+void UBytesPathfinder::AddOrSetEdge(FBytesGraph& Graph, const int32 NodeAID, const int32 NodeBID, const int32 Weight)
+{
+	// Check if the Nodes even Exist
+	if (!Graph.IsValidNode(NodeAID) || !Graph.IsValidNode(NodeBID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Error, one of the Vertices is not in Graph"));
+		return;
+	}
+
+	// Sets both Directions, if the Edges already exist only their Weight gets overridden
+	const bool bExisted = SetDirectedEdge(Graph, NodeAID, NodeBID, Weight);
+	if (NodeAID != NodeBID)
+	{
+		SetDirectedEdge(Graph, NodeBID, NodeAID, Weight);
+	}
+
+	if (bExisted)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Edge Weight gets overridden"));
+	}
+}
 
-void UBytesPathfinder::FindPathsToNodes(FBytesGraph& Graph, const int32 StartID)
+void UBytesPathfinder::AddOrSetDirectedEdge(FBytesGraph& Graph, const int32 FromID, const int32 ToID, const int32 Weight)
 {
-	/* Declare "Unvisited" TSet which contains ID's of unvisited Nodes
-	*  easier to remove Nodes, but should be a sorted queue ideally,
-	*  so we do not have to iterate over the hole Set to find
-	*  the Node with the lowest GCost
-	*/
+	// Check if the Nodes even Exist
+	if (!Graph.IsValidNode(FromID) || !Graph.IsValidNode(ToID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Error, one of the Vertices is not in Graph"));
+		return;
+	}
 
-	// This has to be a reference. When Nodes in the Grid get changed, they wont get changed inside the MinHeap
-	// And because they are not changed, this thing does not work.
-	FBytesPathfindingHeap Unvisited = FBytesPathfindingHeap(Graph.Nodes.Num());
+	MakeDirected(Graph);
+	SetDirectedEdge(Graph, FromID, ToID, Weight);
+}
 
-	// Set Starting Node to 0
-	Graph.Nodes[StartID].GCost = 0;
+void UBytesPathfinder::AddOrSetAsymmetricEdge(FBytesGraph& Graph, const int32 NodeAID, const int32 NodeBID, const int32 WeightAB, const int32 WeightBA)
+{
+	// Check if the Nodes even Exist
+	if (!Graph.IsValidNode(NodeAID) || !Graph.IsValidNode(NodeBID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Error, one of the Vertices is not in Graph"));
+		return;
+	}
 
-	// Add Nodes to Unvisited
-	for (FBytesNode& Node : Graph.Nodes)
+	// Same Weight both Ways is just an undirected Edge
+	if (WeightAB != WeightBA)
 	{
-		// Add Node to Unvisited Array
-		Unvisited.Add(&Node);
+		MakeDirected(Graph);
 	}
 
-	// Remove Late Print
-	// Unvisited.LogHeap();
-	// Unvisited.UpdateItem(&Graph.Nodes[StartNodeID]);
+	SetDirectedEdge(Graph, NodeAID, NodeBID, WeightAB);
+	if (NodeAID != NodeBID)
+	{
+		SetDirectedEdge(Graph, NodeBID, NodeAID, WeightBA);
+	}
+}
 
-	// As long as there are unvisited Tiles we keep searching
-	while (Unvisited.IsNotEmpty())
+void UBytesPathfinder::SetNodeTerrainClass(FBytesGraph& Graph, const int32 NodeID, const uint8 TerrainClass)
+{
+	if (!Graph.IsValidNode(NodeID))
 	{
-		// Find closest and  remove current
-		const auto Node = Unvisited.RemoveFirst();
-		
-		// Was used before: "FindNodeWithLowestGCost(Graph, Unvisited);"
-		// Was Used before: "Unvisited.RemoveSingle(CurrentNodeID);"
+		UE_LOG(LogTemp, Warning, TEXT("Error, Node is not in Graph"));
+		return;
+	}
 
-		for (const auto& NeighbourEdge : Graph.Edges[Node->NodeID].NeighbouringEdges)
-		{
-			// Calculate GCost to Neighbour, which is CurrentNode's GCost + the Edge Weight
-			const int32 Distance = Graph.Nodes[Node->NodeID].GCost + NeighbourEdge.Weight;
+	if (Graph.Nodes[NodeID].TerrainClass != TerrainClass)
+	{
+		Graph.Nodes[NodeID].TerrainClass = TerrainClass;
+		Graph.NumTerrainClasses = FMath::Max(Graph.NumTerrainClasses, TerrainClass + 1);
 
-			// if Distance is closer, update Parent and GCost
-			if (Distance < Graph.Nodes[NeighbourEdge.NodeID].GCost)
-			{
-				Graph.Nodes[NeighbourEdge.NodeID].GCost = Distance;
-				Graph.Nodes[NeighbourEdge.NodeID].ParentID = Node->NodeID;
+		// Profiled Paths through this Node may change
+		Graph.Version++;
+	}
+}
 
-				// Update Entry
-				Unvisited.UpdateItem(&Graph.Nodes[NeighbourEdge.NodeID]);
-			}
-		}
-		
-		// Remove Late Print
-		// Unvisited.LogHeap();
+void UBytesPathfinder::RemoveEdge(FBytesGraph& Graph, const int32 NodeAID, const int32 NodeBID)
+{
+	// Check if the Nodes even Exist
+	if (!Graph.IsValidNode(NodeAID) || !Graph.IsValidNode(NodeBID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Error, one of the Vertices is not in Graph"));
+		return;
 	}
+
+	RemoveDirectedEdgeInternal(Graph, NodeAID, NodeBID);
+	RemoveDirectedEdgeInternal(Graph, NodeBID, NodeAID);
 }
 
-void UBytesPathfinder::FindPath(FBytesGraph& Graph, const int32 StartID, const int32 TargetID)
+void UBytesPathfinder::RemoveDirectedEdge(FBytesGraph& Graph, const int32 FromID, const int32 ToID)
+{
+	// Check if the Nodes even Exist
+	if (!Graph.IsValidNode(FromID) || !Graph.IsValidNode(ToID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Error, one of the Vertices is not in Graph"));
+		return;
+	}
+
+	// Removing only one Direction of an undirected Edge makes the Graph directed
+	MakeDirected(Graph);
+	RemoveDirectedEdgeInternal(Graph, FromID, ToID);
+}
+
+void UBytesPathfinder::RemoveNode(FBytesGraph& Graph, const int32 NodeID)
+{
+	if (!Graph.IsValidNode(NodeID))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Error, Node is not in Graph"));
+		return;
+	}
+
+	// Tombstone the Node. Edges of other Nodes pointing here stay until "CompactGraph()",
+	// Searches skip them
+	Graph.Nodes[NodeID].bRemoved = true;
+	Graph.NumRemovedNodes++;
+
+	// The Node may have been the only Link between two Parts of its Component
+	Graph.Components.bDirty = true;
+	Graph.Version++;
+
+	// Its own Edges are never followed again
+	Graph.Edges[NodeID].NeighbouringEdges.Empty();
+	if (Graph.bDirected)
+	{
+		Graph.ReverseEdges[NodeID].NeighbouringEdges.Empty();
+	}
+}
+
+TArray<int32> UBytesPathfinder::CompactGraph(FBytesGraph& Graph)
 {
-	// Inits Nodes
-	InitNodes(Graph);
+	BYTES_TRACE_SCOPE("CompactGraph");
+
+	const int32 NumNodes = Graph.Nodes.Num();
 
-	// Declare "Open List" and "Closed List"
-	FBytesPathfindingHeap OpenSet = FBytesPathfindingHeap(Graph.Nodes.Num());
-	TSet<int32> ClosedSet;
+	// ==== Sub Section | Remap Table ==== //
 
-	// Add First Node
-	Graph.Nodes[StartID].GCost = 0;
-	Graph.Nodes[StartID].HCost = CalcHeuristicDistance(Graph, StartID, TargetID);
-	OpenSet.Add(&Graph.Nodes[StartID]);
+	TArray<int32> Remap;
+	Remap.SetNumUninitialized(NumNodes);
 
-	while(OpenSet.IsNotEmpty())
+	int32 NumAlive = 0;
+	for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
 	{
-		// Get Current Node
-		auto CurrentNode = OpenSet.RemoveFirst();
+		Remap[NodeID] = Graph.Nodes[NodeID].bRemoved ? INDEX_NONE : NumAlive++;
+	}
 
-		// Add Current Node to Closed List
-		ClosedSet.Add(CurrentNode->NodeID);
+	// Nothing to move, but overwritten Edges may still hold the Heuristic Scale down
+	if (NumAlive == NumNodes)
+	{
+		Graph.RecalculateHeuristicScale();
+		return Remap;
+	}
 
-		// Check if Current is Target
-		if (CurrentNode->NodeID == TargetID)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Path Found"));
-			return;
-		}
-		
-		// Iterate over Neighbours
-		for (const auto& Edge : Graph.Edges[CurrentNode->NodeID].NeighbouringEdges)
+	// ==== Sub Section | Move Nodes and Edges down ==== //
+
+	// New ID's are never higher than old ID's, so everything can be moved in Place
+	auto CompactEdges = [&Remap, NumNodes, NumAlive](TArray<FBytesEdges>& Edges)
+	{
+		for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
 		{
-			// Neighbour
-			const auto Neighbour = &Graph.Nodes[Edge.NodeID];
-			
-			// if Closed List Contains Neighbour, return
-			if (ClosedSet.Contains(Neighbour->NodeID))
+			if (Remap[NodeID] == INDEX_NONE)
 			{
 				continue;
 			}
 
-			// Calculate Cost to Neighbour
-			int32 MovementCost = CurrentNode->GCost + Edge.Weight;
+			TArray<FBytesEdge>& NeighbouringEdges = Edges[NodeID].NeighbouringEdges;
+			NeighbouringEdges.RemoveAllSwap([&Remap](const FBytesEdge& Edge)
+			{
+				return Remap[Edge.NodeID] == INDEX_NONE;
+			}, false);
 
-			// if Neighbour is in OpenList AND has higher GCost return
-			if (OpenSet.Contains(Neighbour) &&  Neighbour->GCost < MovementCost)
+			for (FBytesEdge& Edge : NeighbouringEdges)
 			{
-				continue;
+				Edge.NodeID = Remap[Edge.NodeID];
 			}
 
-			// Set Current Node Parent
-			Neighbour->ParentID = CurrentNode->NodeID;
-
-			// Set New Movement Cost
-			Neighbour->GCost = MovementCost;
-			Neighbour->HCost = CalcHeuristicDistance(Graph, Neighbour->NodeID, TargetID);
-
-			if (OpenSet.Contains(Neighbour))
+			if (Remap[NodeID] != NodeID)
 			{
-				OpenSet.UpdateItem(Neighbour);
-			} else
-			{
-				OpenSet.Add(Neighbour);
+				Edges[Remap[NodeID]] = MoveTemp(Edges[NodeID]);
 			}
 		}
-		
+		Edges.SetNum(NumAlive);
+	};
+
+	CompactEdges(Graph.Edges);
+	if (Graph.bDirected)
+	{
+		CompactEdges(Graph.ReverseEdges);
+	}
+
+	for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+	{
+		if (Remap[NodeID] != INDEX_NONE && Remap[NodeID] != NodeID)
+		{
+			Graph.Nodes[Remap[NodeID]] = Graph.Nodes[NodeID];
+		}
 	}
+	Graph.Nodes.SetNum(NumAlive);
+	Graph.NumRemovedNodes = 0;
+	Graph.Components.bDirty = true;
+	Graph.RecalculateHeuristicScale();
+	Graph.Version++;
 
-	UE_LOG(LogTemp, Warning, TEXT("Pathfinding: No Path Found"));
+	// Old Results point to old ID's
+	Graph.SearchState = FBytesSearchState();
+
+	return Remap;
 }
 
-TArray<int32> UBytesPathfinder::GetNodesInRange(FBytesGraph& Graph, const int32 MaxTravelCost)
+FBytesGraph UBytesPathfinder::BuildGraph(const TArray<FVector2D>& Locations, const TArray<int32>& FromIDs, const TArray<int32>& ToIDs, const TArray<int32>& Weights, const bool bDirected)
 {
-	TArray<int32> ReturnArray;
+	BYTES_TRACE_SCOPE("BuildGraph");
+
+	FBytesGraph Graph;
+
+	if (FromIDs.Num() != ToIDs.Num() || FromIDs.Num() != Weights.Num())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Build Graph: From, To and Weight Arrays need the same Length"));
+		return Graph;
+	}
+
+	const int32 NumNodes = Locations.Num();
+
+	// ==== Sub Section | Nodes ==== //
+
+	Graph.Nodes.SetNum(NumNodes);
+	Graph.Edges.SetNum(NumNodes);
+	for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+	{
+		Graph.Nodes[NodeID].Location2D = Locations[NodeID];
+	}
+
+	// ==== Sub Section | Deduplicate Edges ==== //
+
+	// Directed Edges get a Key of (From, To). Undirected Edges get a Key of (Lower ID, Higher ID),
+	// so A-B and B-A collapse into the same Key.
+	// Sorting by Key and Input Order groups Duplicates, the last one wins, like calling AddOrSetEdge in Order.
+	struct FEdgeEntry
+	{
+		uint64 Key;
+		int32 Order;
+		int32 Weight;
+	};
+
+	TArray<FEdgeEntry> Entries;
+	Entries.Reserve(FromIDs.Num());
 
-	for (const auto& Node : Graph.Nodes)
+	int32 NumInvalid = 0;
+	for (int32 Index = 0; Index < FromIDs.Num(); Index++)
 	{
-		if(Node.GCost <= MaxTravelCost) {
-			ReturnArray.Add(Node.NodeID);
+		const int32 NodeAID = FromIDs[Index];
+		const int32 NodeBID = ToIDs[Index];
+		if (!Graph.Nodes.IsValidIndex(NodeAID) || !Graph.Nodes.IsValidIndex(NodeBID) || NodeAID == NodeBID)
+		{
+			NumInvalid++;
+			continue;
 		}
+
+		const uint64 First = uint32(bDirected ? NodeAID : FMath::Min(NodeAID, NodeBID));
+		const uint64 Second = uint32(bDirected ? NodeBID : FMath::Max(NodeAID, NodeBID));
+		Entries.Add({First << 32 | Second, Index, Weights[Index]});
 	}
 
-	return ReturnArray;
-}
+	if (NumInvalid > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Build Graph: Skipped %d Edges with invalid Node ID's or Self Loops"), NumInvalid);
+	}
 
-TArray<int32> UBytesPathfinder::GetPath(FBytesGraph& Graph, const int32 StartNodeID, const int32 TargetNodeID, const bool bRecalculate)
-{
-	TArray<int32> Path;
+	Entries.Sort([](const FEdgeEntry& A, const FEdgeEntry& B)
+	{
+		return A.Key < B.Key || A.Key == B.Key && A.Order < B.Order;
+	});
 
-	// Check if Indices are valid
-	if (!Graph.Nodes.IsValidIndex(StartNodeID) || !Graph.Nodes.IsValidIndex(TargetNodeID))
+	// Keep only the last Entry of every Key
+	int32 NumUnique = 0;
+	for (int32 Index = 0; Index < Entries.Num(); Index++)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Invalid Node ID's. Out of Range"));
-		return Path;
+		if (Index + 1 < Entries.Num() && Entries[Index + 1].Key == Entries[Index].Key)
+		{
+			continue;
+		}
+		Entries[NumUnique++] = Entries[Index];
 	}
-	
-	// Check if Target Node has ever been reached
-	if (Graph.Nodes[TargetNodeID].ParentID == -1)
+	Entries.SetNum(NumUnique);
+
+	// ==== Sub Section | Emit Adjacency Lists ==== //
+
+	// Directed Graphs store B -> A as Incoming Edge of B, undirected Graphs as regular Edge
+	Graph.bDirected = bDirected;
+	if (bDirected)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Target Node has never been Reached"));
-		return Path;
+		Graph.ReverseEdges.SetNum(NumNodes);
 	}
+	TArray<FBytesEdges>& EdgesBA = bDirected ? Graph.ReverseEdges : Graph.Edges;
 
-	// if we should recalculate the path, we use A*
-	// It Could be that we had a Dijkstra before and cached it, so we dont need to recalc
-	if (bRecalculate)
+	// Count Degrees first, so every Edge List gets allocated exactly once
+	TArray<int32> DegreesAB;
+	TArray<int32> DegreesBA;
+	DegreesAB.Init(0, NumNodes);
+	DegreesBA.Init(0, NumNodes);
+	for (const FEdgeEntry& Entry : Entries)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Pathfinding: Path Found Using A*. Heuristics still SUCK!"));
+		DegreesAB[Entry.Key >> 32]++;
+		DegreesBA[Entry.Key & 0xFFFFFFFF]++;
+	}
 
-		FindPath(Graph, StartNodeID, TargetNodeID);
+	for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+	{
+		if (bDirected)
+		{
+			Graph.Edges[NodeID].NeighbouringEdges.Reserve(DegreesAB[NodeID]);
+			Graph.ReverseEdges[NodeID].NeighbouringEdges.Reserve(DegreesBA[NodeID]);
+		}
+		else
+		{
+			Graph.Edges[NodeID].NeighbouringEdges.Reserve(DegreesAB[NodeID] + DegreesBA[NodeID]);
+		}
 	}
-	
-	// Retrace Path
-	int32 CurrentNodeID = TargetNodeID;
 
-	// Iterate over each parent of current node until we reached Start Node
-	// We Iterate from Target -> Start
-	while(CurrentNodeID != StartNodeID)
+	for (const FEdgeEntry& Entry : Entries)
 	{
-		// Add Current Node to Path
-		Path.Add(CurrentNodeID);
+		const int32 NodeAID = Entry.Key >> 32;
+		const int32 NodeBID = Entry.Key & 0xFFFFFFFF;
 
-		// Set Current Node to Parent ID of current Node
-		CurrentNodeID = Graph.Nodes[CurrentNodeID].ParentID;
+		FBytesEdge EdgeAB;
+		EdgeAB.NodeID = NodeBID;
+		EdgeAB.Weight = Entry.Weight;
+		Graph.Edges[NodeAID].NeighbouringEdges.Add(EdgeAB);
+
+		FBytesEdge EdgeBA;
+		EdgeBA.NodeID = NodeAID;
+		EdgeBA.Weight = Entry.Weight;
+		EdgesBA[NodeBID].NeighbouringEdges.Add(EdgeBA);
 	}
 
-	// Reverse TArray
-	Algo::Reverse(Path);
-	
-	return Path;
+	// ==== Sub Section | Components ==== //
+
+	Graph.Components.Reset(NumNodes);
+	for (const FEdgeEntry& Entry : Entries)
+	{
+		Graph.Components.Union(Entry.Key >> 32, Entry.Key & 0xFFFFFFFF);
+	}
+
+	// Only from the Edges that won, overwritten Duplicates must not lower it
+	Graph.RecalculateHeuristicScale();
+
+	return Graph;
 }
 
-FBytesGraph UBytesPathfinder::CreateGraph()
+int32 UBytesPathfinder::FindNodeWithLowestGCost(const FBytesGraph& Graph, const TArray<int32>& Unvisited)
 {
-	return FBytesGraph();
+	// Closest is random, but negative one will never be set, so there cant be any problems
+	int32 Closest = Unvisited[0];
+	// the "- 1" is very important, as it will loop forever if there are no edges to a Point.
+	// So there is "normally" no problem, but for my debugging adventures this sucks...
+	int32 CurrentCost = Graph.SearchState.GCost[Closest];
+
+	for (const auto NodeID : Unvisited)
+	{
+		// Get Cost
+		const int32 NodeCost = Graph.SearchState.GCost[NodeID];
+
+		// Check if Node has lower than current
+		if (NodeCost < CurrentCost)
+		{
+			Closest = NodeID;
+			CurrentCost = NodeCost;
+		}
+	}
+
+	return Closest;
 }
 
-int32 UBytesPathfinder::AddNode(FBytesGraph& Graph, FVector2D Location2D)
+int32 UBytesPathfinder::CalcHeuristicDistance(const FBytesGraph& Graph, const int32 StartID, const int32 TargetID)
 {
-	// ==== Sub Section | Node ==== //
-	
-	// Create new Node
-	FBytesNode NewNode;
-
-	// Set NodeID to MaxIndex
-	NewNode.NodeID = Graph.Nodes.Num();
+	return BytesSearch::HeuristicDistance(FBytesGraphAccessor(Graph), StartID, TargetID);
+}
 
-	// Add Node to Graph
-	Graph.Nodes.Add(NewNode);
+bool UBytesPathfinder::SetDirectedEdge(FBytesGraph& Graph, const int32 FromID, const int32 ToID, const int32 Weight)
+{
+	Graph.UpdateHeuristicScale(FromID, ToID, Weight);
+	Graph.Components.Union(FromID, ToID);
+	Graph.Version++;
 
-	// Set Location 2D
-	NewNode.Location2D = Location2D;
+	// Checks if the Edge already exists, and only overwrite its Weight
+	FBytesEdge* ExistingEdge = Graph.Edges[FromID].NeighbouringEdges.FindByPredicate([ToID] (const FBytesEdge& Edge)
+	{
+		return Edge.NodeID == ToID;
+	});
 
-	// ==== Sub Section | Edges ==== //
+	if (ExistingEdge)
+	{
+		ExistingEdge->Weight = Weight;
+	}
+	else
+	{
+		FBytesEdge NewEdge;
+		NewEdge.NodeID = ToID;
+		NewEdge.Weight = Weight;
+		Graph.Edges[FromID].NeighbouringEdges.Add(NewEdge);
+	}
 
-	// Create new Edges (Container for multiple "FBytesEdge" Structs)
-	FBytesEdges NewEdges;
+	if (!Graph.bDirected)
+	{
+		return ExistingEdge != nullptr;
+	}
 
-	// Add Edges Container, right after Node gets Created
-	Graph.Edges.Add(NewEdges);
-	
-	// Return ID
-	return NewNode.NodeID;
-}
+	// Mirror into the Incoming Edges of To
+	FBytesEdge* ExistingReverseEdge = Graph.ReverseEdges[ToID].NeighbouringEdges.FindByPredicate([FromID] (const FBytesEdge& Edge)
+	{
+		return Edge.NodeID == FromID;
+	});
 
-void UBytesPathfinder::AddOrSetEdge(FBytesGraph& Graph, const int32 NodeAID, const int32 NodeBID, const int32 Weight)
+	if (ExistingReverseEdge)
 	{
-	// Check if the Nodes even Exist
-	if (!Graph.Nodes.IsValidIndex(NodeAID) || !Graph.Nodes.IsValidIndex(NodeBID))
+		ExistingReverseEdge->Weight = Weight;
+	}
+	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Error, one of the Vertices is not in Graph"));
-		return;
+		FBytesEdge NewReverseEdge;
+		NewReverseEdge.NodeID = FromID;
+		NewReverseEdge.Weight = Weight;
+		Graph.ReverseEdges[ToID].NeighbouringEdges.Add(NewReverseEdge);
 	}
 
-	// Checks if the Edges already exist, and only overwrite their Weight
-	if (Graph.Edges[NodeAID].NeighbouringEdges.ContainsByPredicate([NodeBID] (const FBytesEdge Edge)
+	return ExistingEdge != nullptr;
+}
+
+bool UBytesPathfinder::RemoveDirectedEdgeInternal(FBytesGraph& Graph, const int32 FromID, const int32 ToID)
+{
+	// Edge Order does not matter, so removing is a Swap with the last Edge
+	TArray<FBytesEdge>& NeighbouringEdges = Graph.Edges[FromID].NeighbouringEdges;
+	const int32 EdgeIndex = NeighbouringEdges.IndexOfByPredicate([ToID] (const FBytesEdge& Edge)
 	{
-		return Edge.NodeID == NodeBID;
-	}))
+		return Edge.NodeID == ToID;
+	});
+
+	if (EdgeIndex == INDEX_NONE)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Edge Weight gets overridden"));
+		return false;
+	}
+	NeighbouringEdges.RemoveAtSwap(EdgeIndex, 1, false);
 
-		// Change Edge A
-		for (auto& Edge : Graph.Edges[NodeAID].NeighbouringEdges)
+	// The Edge may have been the only Link between two Parts of its Component
+	Graph.Components.bDirty = true;
+	Graph.Version++;
+
+	if (Graph.bDirected)
+	{
+		TArray<FBytesEdge>& IncomingEdges = Graph.ReverseEdges[ToID].NeighbouringEdges;
+		const int32 ReverseEdgeIndex = IncomingEdges.IndexOfByPredicate([FromID] (const FBytesEdge& Edge)
 		{
-			if (Edge.NodeID == NodeBID)
-			{
-				Edge.Weight = Weight;
-			}
-		}
+			return Edge.NodeID == FromID;
+		});
 
-		// Change Edge B
-		for (auto& Edge : Graph.Edges[NodeBID].NeighbouringEdges)
+		if (ReverseEdgeIndex != INDEX_NONE)
 		{
-			if (Edge.NodeID == NodeAID)
-			{
-				Edge.Weight = Weight;
-			}
+			IncomingEdges.RemoveAtSwap(ReverseEdgeIndex, 1, false);
 		}
+	}
 
-		// Return Early
+	return true;
+}
+
+void UBytesPathfinder::MakeDirected(FBytesGraph& Graph)
+{
+	if (Graph.bDirected)
+	{
 		return;
 	}
 
-	
-	// Create Structs
-	FBytesEdge EdgeAB;
-	FBytesEdge EdgeBA;
-
-	// Set Edge A -> B
-	EdgeAB.Weight = Weight;
-	EdgeAB.NodeID = NodeBID;
+	// Every Edge From -> To becomes an Incoming Edge of To
+	Graph.ReverseEdges.Reset();
+	Graph.ReverseEdges.SetNum(Graph.Nodes.Num());
+	for (int32 FromID = 0; FromID < Graph.Edges.Num(); FromID++)
+	{
+		for (const FBytesEdge& Edge : Graph.Edges[FromID].NeighbouringEdges)
+		{
+			FBytesEdge ReverseEdge;
+			ReverseEdge.NodeID = FromID;
+			ReverseEdge.Weight = Edge.Weight;
+			Graph.ReverseEdges[Edge.NodeID].NeighbouringEdges.Add(ReverseEdge);
+		}
+	}
 
-	// Set Edge B -> A
-	EdgeBA.Weight = Weight;
-	EdgeBA.NodeID = NodeAID;
+	Graph.bDirected = true;
+}
 
-	// Sets Elements
-	Graph.Edges[NodeAID].NeighbouringEdges.Add(EdgeAB);
-	Graph.Edges[NodeBID].NeighbouringEdges.Add(EdgeBA);
+void UBytesPathfinder::InitNodes(FBytesGraph& Graph)
+{
+	// Set GCost to Max, HCost to 0 and Parent to "none" represented by -1.
+	// The Parent is Important for checking if there even is a path to Target!
+	Graph.SearchState.Init(Graph.Nodes.Num(), INITIAL_DISTANCE);
+}
 
+void UBytesPathfinder::RecordSearch(const FBytesGraph& Graph)
+{
+#if BYTES_PATHFINDER_STATS
+	FScopeLock Lock(&SearchTelemetryLock);
+	SearchTelemetry.Record(Graph.LastSearchStats);
+#endif
 }
 
-int32 UBytesPathfinder::FindNodeWithLowestGCost(const FBytesGraph& Graph, const TArray<int32>& Unvisited)
+void UBytesPathfinder::RebuildComponents(FBytesGraph& Graph)
 {
-	// Closest is random, but negative one will never be set, so there cant be any problems
-	int32 Closest = Unvisited[0];
-	// the "- 1" is very important, as it will loop forever if there are no edges to a Point.
-	// So there is "normally" no problem, but for my debugging adventures this sucks...
-	int32 CurrentCost = Graph.Nodes[Closest].GCost;
+	BYTES_TRACE_SCOPE("RebuildComponents");
 
-	for (const auto NodeID : Unvisited)
+	// Removed Nodes have no Edges left, only Edges of other Nodes pointing at them need to be skipped
+	FBytesComponents& Components = Graph.Components;
+	Components.Reset(Graph.Nodes.Num());
+	for (int32 NodeID = 0; NodeID < Graph.Nodes.Num(); NodeID++)
 	{
-		// Get Node
-		const FBytesNode& Node = Graph.Nodes[NodeID];
-
-		// Check if Node has lower than current
-		if (Node.GCost < CurrentCost)
+		for (const FBytesEdge& Edge : Graph.Edges[NodeID].NeighbouringEdges)
 		{
-			Closest = NodeID;
-			CurrentCost = Node.GCost;
+			if (!Graph.Nodes[Edge.NodeID].bRemoved)
+			{
+				Components.Union(NodeID, Edge.NodeID);
+			}
 		}
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("Cost: %d"), CurrentCost);
-	
-	return Closest;
+	// Removals dirty the Components, Edges they took away may have been the cheapest ones
+	Graph.RecalculateHeuristicScale();
 }
 
-int32 UBytesPathfinder::CalcHeuristicDistance(const FBytesGraph& Graph, const int32 StartID, const int32 TargetID)
+const FBytesShortestPathTree& UBytesPathfinder::FindOrBuildTree(FBytesGraph& Graph, const int32 SourceID)
 {
-	auto NodeA = &Graph.Nodes[StartID];
-	auto NodeB = &Graph.Nodes[TargetID];
+	if (const FBytesShortestPathTree* CachedTree = Graph.TreeCache.Find(SourceID, Graph.Version, Graph.Nodes.Num()))
+	{
+		return *CachedTree;
+	}
+
+	BYTES_TRACE_SCOPE_NODES("BuildShortestPathTree", SourceID, INDEX_NONE);
 
-	return FMath::FloorToInt32(FVector2D::Distance(NodeA->Location2D, NodeB->Location2D));
+	// Searches into its own State, the Tree keeps Costs and Parents and the rest gets dropped
+	FBytesSearchState TreeState;
+	RunDijkstra(Graph, FBytesGraphAccessor(Graph), TreeState, SourceID, BeginSearchStats(Graph));
+	RecordSearch(Graph);
+
+	FBytesShortestPathTree Tree;
+	Tree.SourceID = SourceID;
+	Tree.GraphVersion = Graph.Version;
+	Tree.Distance = MoveTemp(TreeState.GCost);
+	Tree.ParentID = MoveTemp(TreeState.ParentID);
+	return Graph.TreeCache.Add(MoveTemp(Tree));
 }
 
-void UBytesPathfinder::InitNodes(FBytesGraph& Graph)
+TArray<int32> UBytesPathfinder::SearchPath(FBytesGraph& Graph, const int32 StartNodeID, const int32 TargetNodeID, const FBytesCostProfile* Profile)
 {
-	// Init Node
-	for (FBytesNode& Node : Graph.Nodes)
+	const FBytesPathCacheKey CacheKey = {StartNodeID, TargetNodeID, Profile ? Profile->GetHash() : 0};
+	if (const TArray<int32>* CachedPath = Graph.PathCache.Find(CacheKey, Graph.Version))
+	{
+		return *CachedPath;
+	}
+
+	// A Search towards another Component would visit every reachable Node before giving up.
+	// Like Cache Hits this does not touch the Search State. Cached, so repeated Probes of an Island skip the Component Lookup too
+	if (!AreNodesConnected(Graph, StartNodeID, TargetNodeID))
+	{
+		BYTES_TRACE_INSTANT("TargetInOtherComponent");
+		Graph.PathCache.Add(CacheKey, Graph.Version, TArray<int32>());
+		return TArray<int32>();
+	}
+
+	TArray<int32> Path;
+	if (ShouldSearchSparse(Graph, StartNodeID, TargetNodeID))
+	{
+		BYTES_TRACE_SCOPE_NODES("FindPathSparse", StartNodeID, TargetNodeID);
+		const FBytesGraphAccessor Accessor(Graph);
+		if (Profile)
+		{
+			RunSparseAStar(Graph, TBytesProfiledGraph<FBytesGraphAccessor>(Accessor, *Profile), Graph.SparseSearchState, StartNodeID, TargetNodeID, BeginSearchStats(Graph));
+		}
+		else
+		{
+			RunSparseAStar(Graph, Accessor, Graph.SparseSearchState, StartNodeID, TargetNodeID, BeginSearchStats(Graph));
+		}
+		RecordSearch(Graph);
+		Path = BytesSearch::RetracePath(Graph.SparseSearchState, StartNodeID, TargetNodeID);
+	}
+	else
+	{
+		if (Profile)
+		{
+			const FBytesGraphAccessor Accessor(Graph);
+			RunAStar(Graph, TBytesProfiledGraph<FBytesGraphAccessor>(Accessor, *Profile), Graph.SearchState, StartNodeID, TargetNodeID, BeginSearchStats(Graph));
+			RecordSearch(Graph);
+		}
+		else
+		{
+			FindPath(Graph, StartNodeID, TargetNodeID);
+		}
+
+		// Retrace Path from Target -> Start
+		Path = BytesSearch::RetracePath(Graph.SearchState, StartNodeID, TargetNodeID);
+	}
+	if (Path.IsEmpty() && StartNodeID != TargetNodeID)
 	{
-		// Set GCosCostt to Max
-		Node.GCost = INITIAL_DISTANCE;
-		Node.HCost = 0;
+		BYTES_TRACE_INSTANT("TargetNeverReached");
+	}
 
-		// Set Parent to "none" represented by -1.
-		// This is Important for checking if there even is a path to Target!
-		Node.ParentID = -1;
+	// Simplified with the same Costs the Search used
+	const FBytesGraphAccessor Accessor(Graph);
+	if (Profile)
+	{
+		SimplifyPathInPlace(TBytesProfiledGraph<FBytesGraphAccessor>(Accessor, *Profile), StartNodeID, Path, Graph.PathSimplification);
 	}
+	else
+	{
+		SimplifyPathInPlace(Accessor, StartNodeID, Path, Graph.PathSimplification);
+	}
+
+	Graph.PathCache.Add(CacheKey, Graph.Version, Path);
+	return Path;
 }
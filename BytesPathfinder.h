@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UObject/Object.h"
+#include "Containers/LruCache.h"
 #include <vector>
 #include "BytesPathfinder.generated.h"
 
@@ -15,49 +16,451 @@ enum class EBytesGraphType : uint8
 	Hexagonal,
 };
 
+// Open List of the Searches, see "FBytesIndexedQueue" and "FBytesLazyQueue"
+UENUM(BlueprintType)
+enum class EBytesSearchQueue : uint8
+{
+	// Decrease Key, every Node is queued once. Best for Graphs where Costs get lowered often
+	IndexedHeap,
+	// Duplicate Entries instead of Decrease Key, cheaper Pushes. Often faster on Grids
+	LazyHeap,
+};
+
+// Search State of recalculated "GetPath()" Queries, see "FBytesSparseSearchState"
+UENUM(BlueprintType)
+enum class EBytesSearchMemory : uint8
+{
+	// Sparse for Queries that are short compared to the Size of the Graph, dense otherwise
+	Automatic,
+	// Arrays over every Node, set up for every Search. Default, so the Search State always holds the last Search
+	Dense,
+	// Hash Table over the reached Nodes only, Setup and Memory do not grow with the Graph
+	Sparse,
+};
+
+// Shape of the Paths "GetPath()" returns, see "BytesSearch::ThetaStar()"
+UENUM(BlueprintType)
+enum class EBytesPathMode : uint8
+{
+	// Cheapest Path along the Edges, every Step is an Edge
+	GraphEdges,
+	// Theta*: Nodes connect straight to any Node they can see, Paths only keep their Corners. Not always the cheapest
+	AnyAngle,
+	// Lazy Theta*: same Paths, but Lines are only tested once a Node gets expanded. Far fewer Line of Sight Checks
+	LazyAnyAngle,
+};
+
+// Post Processing of the Paths "GetPath()" returns, see "BytesSearch::PullString()"
+UENUM(BlueprintType)
+enum class EBytesPathSimplification : uint8
+{
+	// Every Node along the Path
+	None,
+	// Only the Nodes where the Path turns, the Path stays the same
+	RemoveCollinear,
+	// Only the Corners: Nodes that see past their Neighbours on the Path get skipped, if the straight Line is not more expensive
+	PullString,
+};
+
 // ==== Section | Pathfinder Utility Classes/Structs ==== //
 
-// Simple Node with G & H Cost, Parent ID and a Node ID for referencing itself and Objects outside the Pathfinder
+// Cold Node Data, only read for the Heuristic. The Node ID is the Index inside "FBytesGraph::Nodes"
 USTRUCT(BlueprintType)
 struct FBytesNode
 {
 	GENERATED_BODY()
 
-	// Node ID for referencing it back to request
+	// Needed for Calculation of Heuristic
 	UPROPERTY()
-	int32 NodeID = -1;
+	FVector2D Location2D = FVector2D::ZeroVector;
 
+	// Tombstone, removed Nodes keep their ID until the Graph gets compacted
 	UPROPERTY()
-	int32 ParentID = -1;
-	
+	bool bRemoved = false;
+
+	// Terrain of the Node, Cost Profiles scale every Edge leading into it by the Entry of this Class
+	UPROPERTY()
+	uint8 TerrainClass = 0;
+};
+
+/*
+ * Movement Costs of one Unit Type, e.g. Infantry or Cavalry, so one Graph serves every Unit Type.
+ * Every Edge Weight gets scaled by the Entry of the Terrain Class of the Node it leads into, rounded up.
+ */
+USTRUCT(BlueprintType)
+struct BYTESHEXGRIDPLUGIN_API FBytesCostProfile
+{
+	GENERATED_BODY()
+
+	// Cost in Percent of the Edge Weight, indexed by Terrain Class. Negative Entries are impassable, missing Classes cost 100
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pathfinder|Profile")
+	TArray<int32> TerrainCostPercent;
+
+	int32 GetCostPercent(const uint8 TerrainClass) const
+	{
+		return TerrainCostPercent.IsValidIndex(TerrainClass) ? TerrainCostPercent[TerrainClass] : 100;
+	}
+
+	// Lowest passable Entry of the first NumTerrainClasses Classes, scales the Heuristic so it stays consistent
+	int32 GetCheapestPercent(const int32 NumTerrainClasses) const
+	{
+		int32 CheapestPercent = MAX_int32;
+		for (int32 TerrainClass = 0; TerrainClass < NumTerrainClasses; TerrainClass++)
+		{
+			const int32 Percent = GetCostPercent(TerrainClass);
+			if (Percent >= 0)
+			{
+				CheapestPercent = FMath::Min(CheapestPercent, Percent);
+			}
+		}
+		return CheapestPercent == MAX_int32 ? 0 : CheapestPercent;
+	}
+
+	// Identifies the Profile inside Cache Keys
+	uint64 GetHash() const;
+};
+
+/*
+ * Hot Search Data, stored as Structure of Arrays and indexed by Node ID.
+ * The Inner Loop of A* and Dijkstra only touches these, so they stay packed
+ * together in Cache instead of being interleaved with Locations.
+ */
+USTRUCT()
+struct FBytesSearchState
+{
+	GENERATED_BODY()
+
 	// Cost it took to get here
 	UPROPERTY()
-	int32 GCost = 0;
+	TArray<int32> GCost;
 
 	// Heuristic guess about distance to Target
 	UPROPERTY()
-	int32 HCost = 0;
+	TArray<int32> HCost;
 
-	// Needed for Calculation of Heuristic
+	// -1 if the Node has never been reached
 	UPROPERTY()
-	FVector2D Location2D;
+	TArray<int32> ParentID;
 
-	// Index important for Heap
+	// Index important for Heap, -1 if the Node is not inside the Heap
 	UPROPERTY()
-	int32 HeapIndex;
+	TArray<int32> HeapIndex;
+
+	// Resizes all Arrays to NumNodes and resets them for a new Search
+	void Init(const int32 NumNodes, const int32 InitialCost)
+	{
+		GCost.Init(InitialCost, NumNodes);
+		HCost.Init(0, NumNodes);
+		ParentID.Init(INDEX_NONE, NumNodes);
+		HeapIndex.Init(INDEX_NONE, NumNodes);
+	}
+
+	int32 Num() const
+	{
+		return GCost.Num();
+	}
+
+	// A* Only, combines GCost + HCost. 64 Bit, so Costs close to the Limit can not overflow
+	int64 FCost(const int32 NodeID) const
+	{
+		return int64(GCost[NodeID]) + HCost[NodeID];
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return GCost.GetAllocatedSize() + HCost.GetAllocatedSize() + ParentID.GetAllocatedSize() + HeapIndex.GetAllocatedSize();
+	}
+};
+
+/*
+ * Search State for Searches that only reach a small Part of a large Graph. Memory and Setup grow with the reached Nodes, not with the Graph.
+ * An open addressing Table maps Node IDs to Slots. Slots live in fixed Pages, so References to them stay valid while the Table grows.
+ * Same Fields as "FBytesSearchState": "State.GCost[NodeID]" adds the Node on first Access, Access through a const State never adds Nodes.
+ * Works with "FBytesSparseLazyQueue", the indexed Heap needs an Array over every Node.
+ */
+struct BYTESHEXGRIDPLUGIN_API FBytesSparseSearchState
+{
+private:
+	struct FSlot
+	{
+		int32 NodeID;
+		int32 GCost;
+		int32 HCost;
+		int32 ParentID;
+		int32 HeapIndex;
+		bool bClosed;
+	};
+
+	// Indexes the Slot of a reached Node like an Array
+	template<typename ValueType, ValueType FSlot::*Member>
+	struct TField
+	{
+		explicit TField(FBytesSparseSearchState& InOwner)
+			: Owner(InOwner)
+		{
+		}
+
+		ValueType& operator[](const int32 NodeID)
+		{
+			return Owner.FindOrAdd(NodeID).*Member;
+		}
+
+		ValueType operator[](const int32 NodeID) const
+		{
+			return Owner.Find(NodeID).*Member;
+		}
+
+	private:
+		FBytesSparseSearchState& Owner;
+	};
+
+public:
+	FBytesSparseSearchState()
+		: GCost(*this)
+		, HCost(*this)
+		, ParentID(*this)
+		, HeapIndex(*this)
+		, Closed(*this)
+	{
+	}
+
+	// Every Copy starts empty, the Fields point into their own State
+	FBytesSparseSearchState(const FBytesSparseSearchState&)
+		: FBytesSparseSearchState()
+	{
+	}
+
+	FBytesSparseSearchState& operator=(const FBytesSparseSearchState&)
+	{
+		Reset();
+		return *this;
+	}
+
+	TField<int32, &FSlot::GCost> GCost;
+	TField<int32, &FSlot::HCost> HCost;
+	TField<int32, &FSlot::ParentID> ParentID;
+	TField<int32, &FSlot::HeapIndex> HeapIndex;
+
+	// Closed List of "BytesSearch::BestFirstSearch()"
+	TField<bool, &FSlot::bClosed> Closed;
+
+	// Forgets every reached Node for a new Search. Costs O(reached Nodes of the last Search), NumNodes is not needed
+	void Init(const int32 NumNodes, const int32 InitialCost);
+
+	// Frees all Memory
+	void Reset();
+
+	// Nodes reached since the last "Init()"
+	int32 NumReached() const
+	{
+		return NumSlots;
+	}
+
+	int64 FCost(const int32 NodeID) const
+	{
+		const FSlot& Slot = Find(NodeID);
+		return int64(Slot.GCost) + Slot.HCost;
+	}
+
+	bool Contains(const int32 NodeID) const
+	{
+		return FindBucket(NodeID) != INDEX_NONE;
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Buckets.GetAllocatedSize() + Pages.GetAllocatedSize() + Pages.Num() * PageSize * sizeof(FSlot);
+	}
+
+private:
+	static constexpr int32 PageShift = 12;
+	static constexpr int32 PageSize = 1 << PageShift;
+	static constexpr int32 MinBuckets = 64;
+
+	struct FBucket
+	{
+		int32 NodeID;
+		int32 SlotIndex;
+	};
+
+	// Power of two, at most half full. Empty Buckets have the Node ID -1
+	TArray<FBucket> Buckets;
+	uint32 BucketShift = 32;
+
+	// Never resized once allocated, so Slots do not move
+	TArray<TArray<FSlot>> Pages;
+	int32 NumSlots = 0;
+
+	// Unreached Nodes read as this Slot
+	FSlot DefaultSlot = {INDEX_NONE, MAX_int32, 0, INDEX_NONE, INDEX_NONE, false};
+
+	// Fibonacci Hashing, neighbouring Node IDs end up far apart
+	uint32 GetHomeBucket(const int32 NodeID) const
+	{
+		return BucketShift < 32 ? (uint32(NodeID) * 0x9E3779B9u) >> BucketShift : 0;
+	}
+
+	FSlot& GetSlot(const int32 SlotIndex)
+	{
+		return Pages[SlotIndex >> PageShift][SlotIndex & (PageSize - 1)];
+	}
+
+	const FSlot& GetSlot(const int32 SlotIndex) const
+	{
+		return Pages[SlotIndex >> PageShift][SlotIndex & (PageSize - 1)];
+	}
+
+	int32 FindBucket(const int32 NodeID) const
+	{
+		if (Buckets.IsEmpty())
+		{
+			return INDEX_NONE;
+		}
+
+		const uint32 Mask = Buckets.Num() - 1;
+		for (uint32 Index = GetHomeBucket(NodeID); ; Index = (Index + 1) & Mask)
+		{
+			if (Buckets[Index].NodeID == NodeID)
+			{
+				return Index;
+			}
+			if (Buckets[Index].NodeID == INDEX_NONE)
+			{
+				return INDEX_NONE;
+			}
+		}
+	}
+
+	const FSlot& Find(const int32 NodeID) const
+	{
+		const int32 BucketIndex = FindBucket(NodeID);
+		return BucketIndex != INDEX_NONE ? GetSlot(Buckets[BucketIndex].SlotIndex) : DefaultSlot;
+	}
+
+	FSlot& FindOrAdd(const int32 NodeID)
+	{
+		if ((NumSlots + 1) * 2 > Buckets.Num())
+		{
+			SetNumBuckets(FMath::Max(MinBuckets, Buckets.Num() * 2));
+		}
+
+		const uint32 Mask = Buckets.Num() - 1;
+		uint32 Index = GetHomeBucket(NodeID);
+		for (; Buckets[Index].NodeID != INDEX_NONE; Index = (Index + 1) & Mask)
+		{
+			if (Buckets[Index].NodeID == NodeID)
+			{
+				return GetSlot(Buckets[Index].SlotIndex);
+			}
+		}
+
+		if (NumSlots == Pages.Num() * PageSize)
+		{
+			Pages.AddDefaulted_GetRef().SetNumUninitialized(PageSize);
+		}
+
+		Buckets[Index] = {NodeID, NumSlots};
+		FSlot& Slot = GetSlot(NumSlots++);
+		Slot = DefaultSlot;
+		Slot.NodeID = NodeID;
+		return Slot;
+	}
+
+	// Rehashes every reached Node into NumBuckets Buckets, a Power of two
+	void SetNumBuckets(const int32 NumBuckets);
+};
+
+// Searches only count their Stats if this is 1. Shipping Builds skip the Counters, the Structs stay so Blueprints still compile
+#ifndef BYTES_PATHFINDER_STATS
+	#define BYTES_PATHFINDER_STATS !UE_BUILD_SHIPPING
+#endif
+
+// Counters a Search can fill, used to compare Algorithms and spot slow Queries
+USTRUCT(BlueprintType)
+struct FBytesSearchStats
+{
+	GENERATED_BODY()
+
+	// Nodes taken out of the Open List and whose Neighbours got checked
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 NodesExpanded = 0;
+
+	// Neighbours looked at while expanding, including the ones already closed
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 NodesGenerated = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 HeapPushes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 HeapPops = 0;
+
+	// Decrease Key Operations, a Node in the Open List found a cheaper Parent
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 HeapUpdates = 0;
+
+	// Most Nodes inside the Open List at once. Summed Stats keep the Maximum
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 PeakOpenSetSize = 0;
+
+	// Straight Lines tested by any Angle Searches, see "EBytesPathMode"
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 LineOfSightChecks = 0;
 
-	// A* Only, combines GCost + HCost
-	int32 FCost() const
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	double WallTimeSeconds = 0.0;
+
+	FBytesSearchStats& operator+=(const FBytesSearchStats& Other)
 	{
-		return GCost + HCost;
+		NodesExpanded += Other.NodesExpanded;
+		NodesGenerated += Other.NodesGenerated;
+		HeapPushes += Other.HeapPushes;
+		HeapPops += Other.HeapPops;
+		HeapUpdates += Other.HeapUpdates;
+		PeakOpenSetSize = FMath::Max(PeakOpenSetSize, Other.PeakOpenSetSize);
+		LineOfSightChecks += Other.LineOfSightChecks;
+		WallTimeSeconds += Other.WallTimeSeconds;
+		return *this;
 	}
 };
 
-// A Non-Templated Heap for the Pathfinding
+/*
+ * Stats of many Searches, cheap enough to collect in Production.
+ * Histograms use Power of Two Buckets: Bucket 0 counts Zeros, Bucket N counts Values in [2^(N-1), 2^N).
+ */
+USTRUCT(BlueprintType)
+struct BYTESHEXGRIDPLUGIN_API FBytesSearchTelemetry
+{
+	GENERATED_BODY()
+
+	static constexpr int32 NumBuckets = 32;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 NumSearches = 0;
+
+	// Sum of every recorded Search
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	FBytesSearchStats Totals;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	TArray<int64> NodesExpandedHistogram;
+
+	// Wall Time in Microseconds
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	TArray<int64> WallTimeHistogram;
+
+	void Record(const FBytesSearchStats& Stats);
+
+	// Exclusive upper Bound of the Bucket the Percentile (0 - 1) falls into, e.g. 0.99 for the p99
+	static int64 GetPercentile(const TArray<int64>& Histogram, const double Percentile);
+};
+
+// A Non-Templated Heap for the Pathfinding, stores Node ID's and reads Costs from the Search State
 class FBytesPathfindingHeap
 {
 public:
-	explicit FBytesPathfindingHeap(const int32 Capacity)
+	explicit FBytesPathfindingHeap(FBytesSearchState& InState, const int32 Capacity)
+		: State(InState)
 	{
 		// Init Vector with Size
 		Items.resize(Capacity);
@@ -66,30 +469,34 @@ public:
 		Size = 0;
 	}
 
-	void Add(FBytesNode* Node)
+	void Add(const int32 NodeID)
 	{
-		Node->HeapIndex = Size;
-		Items[Size] = Node;
-		SortUp(Node);
+		State.HeapIndex[NodeID] = Size;
+		Items[Size] = NodeID;
 		Size++;
+		SortUp(NodeID);
 	}
 
-	FBytesNode* RemoveFirst()
+	int32 RemoveFirst()
 	{
-		auto First = Items[0];
+		const int32 First = Items[0];
 		Size--;
 		Items[0] = Items[Size];
-		Items[0]->HeapIndex = 0;
+		State.HeapIndex[Items[0]] = 0;
+		State.HeapIndex[First] = INDEX_NONE;
 
-		SortDown(Items[0]);
+		if (Size > 0)
+		{
+			SortDown(Items[0]);
+		}
 		return First;
 	}
 
 	// In a Heap for Pathfinding, we only need to sort up, as they only get changed, when they
 	// become better
-	void UpdateItem(FBytesNode* Node)
+	void UpdateItem(const int32 NodeID)
 	{
-		SortUp(Node);
+		SortUp(NodeID);
 	}
 
 	bool IsNotEmpty() const
@@ -97,30 +504,31 @@ public:
 		return Size > 0;
 	}
 
-	bool Contains(const FBytesNode* Node) const
+	int32 Num() const
 	{
-		for (auto Elem : Items)
-		{
-			if (Node == Elem)
-			{
-				return true;
-			}
-		}
+		return Size;
+	}
 
-		return false;
+	// The Search State knows the Heap Position of every Node, so this is O(1)
+	bool Contains(const int32 NodeID) const
+	{
+		return State.HeapIndex[NodeID] != INDEX_NONE;
 	}
 
 	void LogHeap() const
 	{
 		for (int i = 0; i < Size; i++)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("Heap Position: %d | Distance: %d | ID: %d"), i, Items[i]->FCost(), Items[i]->NodeID);
+			UE_LOG(LogTemp, Warning, TEXT("Heap Position: %d | Distance: %lld | ID: %d"), i, State.FCost(Items[i]), Items[i]);
 		}
 	}
 	
 private:
+	// Costs and Heap Indices live here
+	FBytesSearchState& State;
+
 	// Container 
-	std::vector<FBytesNode*> Items;
+	std::vector<int32> Items;
 
 	// Current Size
 	int32 Size;
@@ -130,29 +538,39 @@ private:
 	int GetLeftChild (const int32 Index) const { return Index * 2 + 1; }
 	int GetRightChild (const int32 Index) const { return Index * 2 + 2; }
 
-	// Sorting
-	void SortUp(FBytesNode* Node) 
+	// Lower FCost first, ties are broken by the lower HCost
+	bool HasHigherPriority(const int32 A, const int32 B) const
 	{
-		// Get Parent
-		FBytesNode* Parent = Items[GetParent(Node->HeapIndex)];
+		const int64 FCostA = State.FCost(A);
+		const int64 FCostB = State.FCost(B);
+		return FCostA < FCostB || FCostA == FCostB && State.HCost[A] < State.HCost[B];
+	}
 
-		// When the Child has a higher priority than the parent, we swap them
-		if (Node->FCost() < Parent->FCost() || Node->FCost() == Parent->FCost() && Node->HCost < Parent->HCost)
+	// Sorting
+	void SortUp(const int32 NodeID)
+	{
+		while (State.HeapIndex[NodeID] > 0)
 		{
-			// Switch Positions
-			Swap(Parent, Node);
+			// Get Parent
+			const int32 Parent = Items[GetParent(State.HeapIndex[NodeID])];
+
+			// When the Child has a higher priority than the parent, we swap them
+			if (!HasHigherPriority(NodeID, Parent))
+			{
+				return;
+			}
 
-			// Recursive calling until Node is high enough
-			SortUp(Node);
+			// Switch Positions
+			Swap(Parent, NodeID);
 		}
 	}
 
-	void SortDown(FBytesNode* Node)
+	void SortDown(const int32 NodeID)
 	{
 		while (true)
 		{
-			auto LIndex = GetLeftChild(Node->HeapIndex);
-			auto RIndex = GetRightChild(Node->HeapIndex);
+			auto LIndex = GetLeftChild(State.HeapIndex[NodeID]);
+			auto RIndex = GetRightChild(State.HeapIndex[NodeID]);
 			auto SwapIndex = 0;
 			
 			if (LIndex < Size)
@@ -162,17 +580,16 @@ private:
 				if(RIndex < Size)
 				{
 					// Check if we switch with left or right child
-					if (Items[LIndex]->FCost() > Items[RIndex]->FCost() || Items[LIndex]->FCost() == Items[RIndex]->FCost() && Items[LIndex]->HCost > Items[RIndex]->HCost)
+					if (HasHigherPriority(Items[RIndex], Items[LIndex]))
 					{
 						SwapIndex = RIndex;
 					}
 				}
 
 				// Check if we swap at all
-				auto ItemToSwap = Items[SwapIndex];
-				if (Node->FCost() > ItemToSwap->FCost() || Node->FCost() == ItemToSwap->FCost() && Node->HCost > ItemToSwap->HCost)
+				if (HasHigherPriority(Items[SwapIndex], NodeID))
 				{
-					Swap(Node, Items[SwapIndex]);
+					Swap(NodeID, Items[SwapIndex]);
 				}
 				else
 				{
@@ -186,16 +603,16 @@ private:
 		}
 	}
 
-	void Swap(FBytesNode* X, FBytesNode* Y)
+	void Swap(const int32 X, const int32 Y)
 	{
 		// switch vector positions
-		Items[X->HeapIndex] = Y;
-		Items[Y->HeapIndex] = X;
+		Items[State.HeapIndex[X]] = Y;
+		Items[State.HeapIndex[Y]] = X;
 
-		int Temp = X->HeapIndex;
+		int Temp = State.HeapIndex[X];
 
-		X->HeapIndex = Y->HeapIndex;
-		Y->HeapIndex = Temp;
+		State.HeapIndex[X] = State.HeapIndex[Y];
+		State.HeapIndex[Y] = Temp;
 	}
 };
 
@@ -224,62 +641,694 @@ struct FBytesEdges
 	TArray<FBytesEdge> NeighbouringEdges;
 };
 
-// ==== The Graph itself we perform our Pathfinding on ==== //
-USTRUCT(BlueprintType)
-struct BYTESHEXGRIDPLUGIN_API FBytesGraph
+/*
+ * Weakly connected Components as Union Find, Edge Directions are ignored.
+ * Nodes in different Components can never reach each other, so Queries between them get rejected without a Search.
+ * Adding Edges only merges Components. Removing Edges or Nodes may split them, that marks them dirty
+ * and they get rebuilt before the next Query.
+ */
+USTRUCT()
+struct FBytesComponents
 {
 	GENERATED_BODY()
-	
-	UPROPERTY()
-	TArray<FBytesNode> Nodes;
 
+	// Parent of every Node inside the Union Find. Roots store their negative Component Size instead
 	UPROPERTY()
-	TArray<FBytesEdges> Edges;
+	TArray<int32> Parent;
 
 	UPROPERTY()
-	EBytesGraphType GraphType;
-};
+	bool bDirty = false;
 
-// ==== Section | Pathfinder BP Function Library ==== //
-UCLASS(BlueprintType, DefaultToInstanced)
-class BYTESHEXGRIDPLUGIN_API UBytesPathfinder : public UBlueprintFunctionLibrary
-{
-	GENERATED_BODY()
+	bool NeedsRebuild(const int32 NumNodes) const
+	{
+		return bDirty || Parent.Num() != NumNodes;
+	}
 
-	/*
-	 * Change Name...
-	 *
-	 * This Basically performs a Dijkstra on a Graph.
-	 * After this has been performed, you can use the "GetPath()" Method
-	 * to get a TArray<int32> which contains the NodeID's.
-	 */
-	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
-	static void FindPathsToNodes(UPARAM(ref) FBytesGraph& Graph, const int32 StartID);
+	// Every new Node starts as its own Component. Components of Graphs saved before they existed get rebuilt instead
+	void AddNode(const int32 NodeID)
+	{
+		if (Parent.Num() == NodeID)
+		{
+			Parent.Add(-1);
+		}
+		else
+		{
+			bDirty = true;
+		}
+	}
 
-	UFUNCTION()
-	static void FindPath(FBytesGraph& Graph, const int32 StartID, const int32 TargetID);
+	// Resets every Node to its own Component
+	void Reset(const int32 NumNodes)
+	{
+		Parent.Init(-1, NumNodes);
+		bDirty = false;
+	}
 
-	/*
-	 * Only call after "Find Paths to Nodes
-	 * Returns all NodeID's of reachable Nodes.
-	 */
-	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
-	static TArray<int32> GetNodesInRange(UPARAM(ref) FBytesGraph& Graph, const int32 MaxTravelCost);
+	// Root of the Node's Component. Halves the Path on the Way, so repeated Lookups are O(1)
+	int32 Find(int32 NodeID)
+	{
+		while (Parent[NodeID] >= 0)
+		{
+			const int32 GrandParent = Parent[Parent[NodeID]];
+			if (GrandParent >= 0)
+			{
+				Parent[NodeID] = GrandParent;
+			}
+			NodeID = Parent[NodeID];
+		}
+		return NodeID;
+	}
 
-	/*
-	 * StartNodeID: The ID of the starting Node
-	 * TargetNodeID: The ID of the targeted Node
-	 * bRecalculate: Performs A* if true, else uses Graph as is
-	 */
-	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
-	static TArray<int32> GetPath(UPARAM(ref) FBytesGraph& Graph, const int32 StartNodeID, const int32 TargetNodeID, bool bRecalculate);
+	// Same as "Find()" without compressing Paths, for const Callers
+	int32 FindRoot(int32 NodeID) const
+	{
+		while (Parent[NodeID] >= 0)
+		{
+			NodeID = Parent[NodeID];
+		}
+		return NodeID;
+	}
 
-	/*
-	 * Returns a new Graph
-	 */
-	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	// Merges the Components of both Nodes, the smaller one gets attached to the larger one
+	void Union(const int32 NodeAID, const int32 NodeBID)
+	{
+		// A Rebuild is pending anyway, it will see this Edge
+		if (bDirty || !Parent.IsValidIndex(NodeAID) || !Parent.IsValidIndex(NodeBID))
+		{
+			bDirty = true;
+			return;
+		}
+
+		int32 RootA = Find(NodeAID);
+		int32 RootB = Find(NodeBID);
+		if (RootA == RootB)
+		{
+			return;
+		}
+
+		if (Parent[RootA] > Parent[RootB])
+		{
+			Swap(RootA, RootB);
+		}
+		Parent[RootA] += Parent[RootB];
+		Parent[RootB] = RootA;
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Parent.GetAllocatedSize();
+	}
+};
+
+// Hit Rate of the Path Cache and the Tree Cache, see "FBytesPathCache" and "FBytesTreeCache"
+USTRUCT(BlueprintType)
+struct FBytesPathCacheStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 Hits = 0;
+
+	// Includes the Invalidations
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 Misses = 0;
+
+	// Entries found, but computed before the last Graph Edit
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 Invalidations = 0;
+
+	// Entries dropped because the Cache was full or over its Budget
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Stats")
+	int64 Evictions = 0;
+
+	double GetHitRate() const
+	{
+		return Hits + Misses > 0 ? double(Hits) / double(Hits + Misses) : 0.0;
+	}
+};
+
+// Identifies one cached Query
+struct FBytesPathCacheKey
+{
+	int32 StartID = INDEX_NONE;
+	int32 TargetID = INDEX_NONE;
+
+	// "FBytesCostProfile::GetHash()", 0 for Queries without Profile
+	uint64 ProfileHash = 0;
+
+	bool operator==(const FBytesPathCacheKey& Other) const
+	{
+		return StartID == Other.StartID && TargetID == Other.TargetID && ProfileHash == Other.ProfileHash;
+	}
+
+	friend uint32 GetTypeHash(const FBytesPathCacheKey& Key)
+	{
+		return HashCombineFast(HashCombineFast(GetTypeHash(Key.StartID), GetTypeHash(Key.TargetID)), GetTypeHash(Key.ProfileHash));
+	}
+};
+
+/*
+ * Least recently used Cache of "UBytesPathfinder::GetPath()" Results, disabled while the Capacity is 0.
+ * Every Entry remembers the Graph Version it was computed for. Graph Edits bump the Version,
+ * so stale Entries never get returned and are dropped when they are looked up.
+ * Copies of a Graph start with an empty Cache of the same Capacity.
+ */
+struct BYTESHEXGRIDPLUGIN_API FBytesPathCache
+{
+	FBytesPathCache() = default;
+	FBytesPathCache(FBytesPathCache&&) = default;
+	FBytesPathCache& operator=(FBytesPathCache&&) = default;
+
+	FBytesPathCache(const FBytesPathCache& Other)
+	{
+		SetCapacity(Other.GetCapacity());
+	}
+
+	FBytesPathCache& operator=(const FBytesPathCache& Other)
+	{
+		SetCapacity(Other.GetCapacity());
+		return *this;
+	}
+
+	// Drops every Entry. 0 disables the Cache
+	void SetCapacity(const int32 Capacity);
+
+	int32 GetCapacity() const
+	{
+		return Entries ? Entries->Max() : 0;
+	}
+
+	int32 Num() const
+	{
+		return Entries ? Entries->Num() : 0;
+	}
+
+	// Returns the cached Path if it was computed for this Graph Version, nullptr otherwise
+	const TArray<int32>* Find(const FBytesPathCacheKey& Key, const uint32 GraphVersion);
+
+	void Add(const FBytesPathCacheKey& Key, const uint32 GraphVersion, const TArray<int32>& Path);
+
+	const FBytesPathCacheStats& GetStats() const
+	{
+		return Stats;
+	}
+
+	void ResetStats()
+	{
+		Stats = FBytesPathCacheStats();
+	}
+
+private:
+	struct FEntry
+	{
+		uint32 GraphVersion;
+		TArray<int32> Path;
+	};
+
+	// Only allocated while the Cache is enabled
+	TUniquePtr<TLruCache<FBytesPathCacheKey, FEntry>> Entries;
+
+	FBytesPathCacheStats Stats;
+};
+
+// Full Dijkstra Result of one Source, see "FBytesTreeCache"
+struct FBytesShortestPathTree
+{
+	int32 SourceID = INDEX_NONE;
+	uint32 GraphVersion = 0;
+
+	// Lookup Tick of the Cache, the lowest one gets evicted first
+	uint64 LastUsed = 0;
+
+	// Cost from the Source, unreachable Nodes keep INITIAL_DISTANCE
+	TArray<int32> Distance;
+
+	// Previous Node on the cheapest Path from the Source, -1 for the Source and unreachable Nodes
+	TArray<int32> ParentID;
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return Distance.GetAllocatedSize() + ParentID.GetAllocatedSize();
+	}
+};
+
+/*
+ * Shortest Path Trees of several Sources, so Ranges and Paths of many Units can be answered again without searching.
+ * Bounded by a Budget in Bytes, the least recently used Trees get dropped first. The most recent Tree is always kept,
+ * even if it alone is over Budget. Trees are invalidated by the Graph Version like the Path Cache, copies start empty.
+ */
+struct BYTESHEXGRIDPLUGIN_API FBytesTreeCache
+{
+	FBytesTreeCache() = default;
+	FBytesTreeCache(FBytesTreeCache&&) = default;
+	FBytesTreeCache& operator=(FBytesTreeCache&&) = default;
+
+	FBytesTreeCache(const FBytesTreeCache& Other)
+		: MaxBytes(Other.MaxBytes)
+	{
+	}
+
+	FBytesTreeCache& operator=(const FBytesTreeCache& Other)
+	{
+		MaxBytes = Other.MaxBytes;
+		Trees.Reset();
+		return *this;
+	}
+
+	// Drops every Tree
+	void SetBudget(const int64 InMaxBytes)
+	{
+		MaxBytes = FMath::Max<int64>(InMaxBytes, 0);
+		Trees.Reset();
+	}
+
+	int64 GetBudget() const
+	{
+		return MaxBytes;
+	}
+
+	int32 Num() const
+	{
+		return Trees.Num();
+	}
+
+	// Returns the Tree of the Source if it was computed for this Graph Version, nullptr otherwise
+	const FBytesShortestPathTree* Find(const int32 SourceID, const uint32 GraphVersion, const int32 NumNodes);
+
+	// Stores a new Tree and evicts old ones until the Budget fits again
+	const FBytesShortestPathTree& Add(FBytesShortestPathTree&& Tree);
+
+	const FBytesPathCacheStats& GetStats() const
+	{
+		return Stats;
+	}
+
+private:
+	// Few Trees fit into any sensible Budget, so a linear Scan is cheaper than hashing
+	TArray<FBytesShortestPathTree> Trees;
+
+	int64 MaxBytes = 0;
+	uint64 Tick = 0;
+
+	FBytesPathCacheStats Stats;
+};
+
+/*
+ * Cost from every Node to each Target of the Multi Agent Planners, see "UBytesMultiAgent".
+ * Tables are invalidated by the Graph Version and Node Count, copies start empty.
+ */
+struct BYTESHEXGRIDPLUGIN_API FBytesTargetCostCache
+{
+	FBytesTargetCostCache() = default;
+	FBytesTargetCostCache(FBytesTargetCostCache&&) = default;
+	FBytesTargetCostCache& operator=(FBytesTargetCostCache&&) = default;
+
+	FBytesTargetCostCache(const FBytesTargetCostCache&)
+	{
+	}
+
+	FBytesTargetCostCache& operator=(const FBytesTargetCostCache&)
+	{
+		Costs.Reset();
+		return *this;
+	}
+
+	// INITIAL_DISTANCE where TargetID can not be reached from. Valid until the next Call
+	const TArray<int32>& FindOrBuild(const struct FBytesGraph& Graph, const int32 TargetID);
+
+	// Starts over once it holds many more Targets than NumInUse
+	void Trim(const int32 NumInUse);
+
+	int32 Num() const
+	{
+		return Costs.Num();
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Size = Costs.GetAllocatedSize();
+		for (const auto& Pair : Costs)
+		{
+			Size += Pair.Value.GetAllocatedSize();
+		}
+		return Size;
+	}
+
+private:
+	TMap<int32, TArray<int32>> Costs;
+	uint32 GraphVersion = 0;
+	int32 NumNodes = 0;
+};
+
+// ==== The Graph itself we perform our Pathfinding on ==== //
+USTRUCT(BlueprintType)
+struct BYTESHEXGRIDPLUGIN_API FBytesGraph
+{
+	GENERATED_BODY()
+	
+	UPROPERTY()
+	TArray<FBytesNode> Nodes;
+
+	UPROPERTY()
+	TArray<FBytesEdges> Edges;
+
+	// Incoming Edges of every Node, the Edge NodeID is the Source. Only filled for directed Graphs,
+	// undirected Graphs are their own Reverse
+	UPROPERTY()
+	TArray<FBytesEdges> ReverseEdges;
+
+	// Set once the first directed or asymmetric Edge gets added
+	UPROPERTY()
+	bool bDirected = false;
+
+	// Tombstoned Nodes since the last Compaction, Searches only check Tombstones if this is not 0
+	UPROPERTY()
+	int32 NumRemovedNodes = 0;
+
+	// Highest Terrain Class of any Node + 1, Cost Profiles only need to look at these Classes
+	UPROPERTY()
+	int32 NumTerrainClasses = 1;
+
+	// Multiplier for the Euclidean Heuristic: the lowest Weight per Unit of Distance of any Edge, at most 1.
+	// Keeps the Heuristic consistent, even if Weights are smaller than the Distances between Locations.
+	// New Edges only lower it, "CompactGraph()" and Component Rebuilds recalculate it from the remaining Edges.
+	UPROPERTY()
+	double HeuristicScale = 1.0;
+
+	// Results of the last Search, indexed by Node ID
+	UPROPERTY()
+	FBytesSearchState SearchState;
+
+	// Not serialized, recalculated Paths search in here instead if "SearchMemory" picks the sparse State. Multi Agent Searches keep their (Node, Turn) Pairs in here too
+	FBytesSparseSearchState SparseSearchState;
+
+	// Counters of the last Search, only filled if BYTES_PATHFINDER_STATS is enabled
+	UPROPERTY()
+	FBytesSearchStats LastSearchStats;
+
+	// Kept up to Date by every Graph Function, use "UBytesPathfinder::AreNodesConnected()" to query them
+	UPROPERTY()
+	FBytesComponents Components;
+
+	// Bumped by every Edit that can change a Path, so cached Results can tell they are stale
+	UPROPERTY()
+	uint32 Version = 0;
+
+	// Not serialized, every loaded or copied Graph starts cold
+	FBytesPathCache PathCache;
+
+	// Not serialized, see "UBytesPathfinder::GetPathFromSource()"
+	FBytesTreeCache TreeCache;
+
+	// Not serialized, Heuristic of "UBytesMultiAgent::PlanCooperativePaths()" and "UBytesMultiAgent::PlanOptimalPaths()"
+	FBytesTargetCostCache TargetCostCache;
+
+	UPROPERTY()
+	EBytesGraphType GraphType;
+
+	// Open List every Search on this Graph uses
+	UPROPERTY()
+	EBytesSearchQueue SearchQueue = EBytesSearchQueue::IndexedHeap;
+
+	// Used by "FindPath()" and every recalculated Path
+	UPROPERTY()
+	EBytesPathMode PathMode = EBytesPathMode::GraphEdges;
+
+	// Search State of recalculated Paths, see "UBytesPathfinder::SetSearchMemory()"
+	UPROPERTY()
+	EBytesSearchMemory SearchMemory = EBytesSearchMemory::Dense;
+
+	// Inflation of the A* Heuristic, see "UBytesPathfinder::SetHeuristicWeight()"
+	UPROPERTY()
+	double HeuristicWeight = 1.0;
+
+	// Applied to every Path "GetPath()" returns, cached Paths are stored simplified
+	UPROPERTY()
+	EBytesPathSimplification PathSimplification = EBytesPathSimplification::None;
+
+	bool IsValidNode(const int32 NodeID) const
+	{
+		return Nodes.IsValidIndex(NodeID) && !Nodes[NodeID].bRemoved;
+	}
+
+	// Lowers the Heuristic Scale if this Edge is cheaper than its Length
+	void UpdateHeuristicScale(const int32 FromID, const int32 ToID, const int32 Weight)
+	{
+		const double Length = FVector2D::Distance(Nodes[FromID].Location2D, Nodes[ToID].Location2D);
+		if (Length > 0.0)
+		{
+			HeuristicScale = FMath::Min(HeuristicScale, FMath::Max(Weight, 0) / Length);
+		}
+	}
+
+	// Raises the Heuristic Scale back up once cheap Edges got removed or overwritten
+	void RecalculateHeuristicScale()
+	{
+		HeuristicScale = 1.0;
+		for (int32 NodeID = 0; NodeID < Nodes.Num(); NodeID++)
+		{
+			for (const FBytesEdge& Edge : Edges[NodeID].NeighbouringEdges)
+			{
+				if (!Nodes[Edge.NodeID].bRemoved)
+				{
+					UpdateHeuristicScale(NodeID, Edge.NodeID, Edge.Weight);
+				}
+			}
+		}
+	}
+
+	// Bytes used by Nodes, Edges and Search State
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Size = Nodes.GetAllocatedSize() + Edges.GetAllocatedSize() + ReverseEdges.GetAllocatedSize() + SearchState.GetAllocatedSize() + SparseSearchState.GetAllocatedSize() + Components.GetAllocatedSize()
+			+ TargetCostCache.GetAllocatedSize();
+		for (const FBytesEdges& NodeEdges : Edges)
+		{
+			Size += NodeEdges.NeighbouringEdges.GetAllocatedSize();
+		}
+		for (const FBytesEdges& NodeEdges : ReverseEdges)
+		{
+			Size += NodeEdges.NeighbouringEdges.GetAllocatedSize();
+		}
+		return Size;
+	}
+};
+
+// ==== Section | Pathfinder BP Function Library ==== //
+UCLASS(BlueprintType, DefaultToInstanced)
+class BYTESHEXGRIDPLUGIN_API UBytesPathfinder : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+	/*
+	 * Change Name...
+	 *
+	 * This Basically performs a Dijkstra on a Graph.
+	 * After this has been performed, you can use the "GetPath()" Method
+	 * to get a TArray<int32> which contains the NodeID's.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static void FindPathsToNodes(UPARAM(ref) FBytesGraph& Graph, const int32 StartID);
+
+	UFUNCTION()
+	static void FindPath(FBytesGraph& Graph, const int32 StartID, const int32 TargetID);
+
+	/*
+	 * Backwards Dijkstra, follows Edges against their Direction.
+	 * Afterwards every Node's GCost is the Cost to reach TargetID and its Parent
+	 * is the next Step towards TargetID. Use "GetPathToTarget()" to read Paths.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static void FindPathsFromNodes(UPARAM(ref) FBytesGraph& Graph, const int32 TargetID);
+
+	/*
+	 * Only call after "Find Paths from Nodes"
+	 * Returns the NodeID's from StartNodeID (excluded) to TargetNodeID
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static TArray<int32> GetPathToTarget(UPARAM(ref) FBytesGraph& Graph, const int32 StartNodeID, const int32 TargetNodeID);
+
+	/*
+	 * Only call after "Find Paths to Nodes
+	 * Returns all NodeID's of reachable Nodes.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static TArray<int32> GetNodesInRange(UPARAM(ref) FBytesGraph& Graph, const int32 MaxTravelCost);
+
+	/*
+	 * StartNodeID: The ID of the starting Node
+	 * TargetNodeID: The ID of the targeted Node
+	 * bRecalculate: Performs A* if true, else uses Graph as is.
+	 * Targets in another Component are rejected before searching.
+	 * With the Path Cache enabled, recalculated Paths come from the Cache if possible.
+	 * Cache Hits and rejected Targets do not touch the Search State, it keeps the last Search.
+	 * Recalculated Paths follow the Path Mode of the Graph, see "SetPathMode()".
+	 * Short Queries may search the sparse State instead if enabled by "SetSearchMemory()".
+	 * Every Path gets simplified as set by "SetPathSimplification()".
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static TArray<int32> GetPath(UPARAM(ref) FBytesGraph& Graph, const int32 StartNodeID, const int32 TargetNodeID, bool bRecalculate);
+
+	/*
+	 * False if no Path between both Nodes can exist, without searching.
+	 * Directions are ignored, so on directed Graphs true only means a Path may exist.
+	 * The first Call after removing Edges or Nodes rebuilds the Components in O(V + E).
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static bool AreNodesConnected(UPARAM(ref) FBytesGraph& Graph, const int32 NodeAID, const int32 NodeBID);
+
+	/*
+	 * A* with the Edge Weights scaled by the Cost Profile, see "FBytesCostProfile".
+	 * Returns the NodeID's from StartNodeID (excluded) to TargetNodeID. Uses the Path Cache like "GetPath()".
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static TArray<int32> GetPathWithProfile(UPARAM(ref) FBytesGraph& Graph, const int32 StartNodeID, const int32 TargetNodeID, const FBytesCostProfile& Profile);
+
+	/*
+	 * "FindPathsToNodes()" with the Edge Weights scaled by the Cost Profile.
+	 * Afterwards "GetNodesInRange()" returns the Movement Range of the Unit Type.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static void FindPathsToNodesWithProfile(UPARAM(ref) FBytesGraph& Graph, const int32 StartID, const FBytesCostProfile& Profile);
+
+	/*
+	 * Enables the Path Cache of the Graph for up to Capacity recalculated "GetPath()" Results, 0 disables it.
+	 * Drops all cached Paths.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static void SetPathCacheCapacity(UPARAM(ref) FBytesGraph& Graph, const int32 Capacity);
+
+	/*
+	 * Open List for every following Search on the Graph. Both find equally cheap Paths,
+	 * only Ties between equally cheap Paths may be broken differently.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static void SetSearchQueue(UPARAM(ref) FBytesGraph& Graph, const EBytesSearchQueue SearchQueue);
+
+	/*
+	 * Search State for every following recalculated "GetPath()" along the Edges. The sparse State only holds the reached Nodes,
+	 * so short Queries on huge Graphs skip setting up Arrays over every Node. It always uses the lazy Heap.
+	 * Automatic picks it if a Disk around Start as wide as the Distance to the Target holds a small Part of all Nodes,
+	 * measured in the mean Edge Length around Start. Dense by default.
+	 * Sparse Searches do not touch the Search State of the Graph, like Cache Hits and rejected Targets: "GetPath()" without Recalculation,
+	 * "GetPathToTarget()" and "GetNodesInRange()" keep reading the last dense Search, so only enable it where nothing reads those afterwards.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static void SetSearchMemory(UPARAM(ref) FBytesGraph& Graph, const EBytesSearchMemory SearchMemory);
+
+	/*
+	 * Any Angle Paths skip every Node between two Corners, so consecutive Path Nodes may be far apart.
+	 * Lines of Sight walk the Edges close to the Line, see "FBytesGraphLineOfSight". Drops all cached Paths.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static void SetPathMode(UPARAM(ref) FBytesGraph& Graph, const EBytesPathMode PathMode);
+
+	/*
+	 * Simplification for every following "GetPath()" and "GetPathWithProfile()". Long Grid Paths shrink to their Corners,
+	 * consecutive Path Nodes are then connected by straight Lines instead of Edges. Drops all cached Paths.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static void SetPathSimplification(UPARAM(ref) FBytesGraph& Graph, const EBytesPathSimplification Simplification);
+
+	/*
+	 * Weighted A* for every following "FindPath()" and "GetPath()" along the Edges: the Heuristic gets multiplied by Weight,
+	 * so far fewer Nodes get expanded and Paths cost at most Weight times the cheapest Path. 1 finds the cheapest Path.
+	 * Drops all cached Paths.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static void SetHeuristicWeight(UPARAM(ref) FBytesGraph& Graph, const double Weight);
+
+	/*
+	 * Anytime A* (ARA*, see "TBytesAnytimeAStar"): finds a Path with InitialWeight first and keeps improving it,
+	 * reusing the Work of earlier Iterations, until it is the cheapest or MaxMilliseconds have passed.
+	 * The first Iteration always finishes. Read the Path with "GetPath()" without recalculating.
+	 * Returns the Suboptimality Bound of the Path (1 is the cheapest Path), or -1 if there is none.
+	 * Targets in another Component return -1 without searching, the Search State then still holds the last Search.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static double FindPathAnytime(UPARAM(ref) FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const double InitialWeight, const double MaxMilliseconds);
+
+	/*
+	 * Simplifies any Path in the "GetPath()" Format, e.g. from "GetPathToTarget()" or "GetPathFromSource()".
+	 * Lines of Sight walk the Edges close to the Line, see "FBytesGraphLineOfSight".
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static TArray<int32> SimplifyPath(const FBytesGraph& Graph, const int32 StartNodeID, const TArray<int32>& Path, const EBytesPathSimplification Simplification);
+
+	UFUNCTION(BlueprintPure, Category="Pathfinder|Stats")
+	static FBytesPathCacheStats GetPathCacheStats(const FBytesGraph& Graph);
+
+	UFUNCTION(BlueprintPure, Category="Pathfinder|Stats")
+	static double GetPathCacheHitRate(const FBytesGraph& Graph);
+
+	/*
+	 * Memory the Graph may use for cached Shortest Path Trees, see "FBytesTreeCache". Drops all cached Trees.
+	 * The most recent Tree is always kept, so a Budget of 0 still caches one Source.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static void SetTreeCacheBudget(UPARAM(ref) FBytesGraph& Graph, const int64 MaxBytes);
+
+	/*
+	 * Cheapest Path from SourceID (excluded) to TargetID, read from the cached Tree of SourceID.
+	 * Runs Dijkstra once if the Source has no valid Tree yet, that replaces "GetLastSearchStats()". Does not touch the Search State.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static TArray<int32> GetPathFromSource(UPARAM(ref) FBytesGraph& Graph, const int32 SourceID, const int32 TargetID);
+
+	// Cost of the cheapest Path from SourceID to TargetID, -1 if unreachable. Uses the Tree Cache
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static int32 GetTravelCostFromSource(UPARAM(ref) FBytesGraph& Graph, const int32 SourceID, const int32 TargetID);
+
+	// All Nodes SourceID can reach for at most MaxTravelCost, e.g. the Movement Range of a Unit. Uses the Tree Cache
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Pathfinding")
+	static TArray<int32> GetNodesInRangeFromSource(UPARAM(ref) FBytesGraph& Graph, const int32 SourceID, const int32 MaxTravelCost);
+
+	UFUNCTION(BlueprintPure, Category="Pathfinder|Stats")
+	static FBytesPathCacheStats GetTreeCacheStats(const FBytesGraph& Graph);
+
+	/*
+	 * Counters of the last Search on this Graph: "FindPath", "FindPathAnytime", "FindPathsToNodes", "FindPathsToNodesWithProfile",
+	 * "FindPathsFromNodes", a recalculated "GetPath" or "GetPathWithProfile", or a Tree built for "GetPathFromSource",
+	 * "GetTravelCostFromSource" or "GetNodesInRangeFromSource". Cache Hits and rejected Queries keep the Counters of the Search before.
+	 * Always empty in Shipping Builds.
+	 */
+	UFUNCTION(BlueprintPure, Category="Pathfinder|Stats")
+	static FBytesSearchStats GetLastSearchStats(const FBytesGraph& Graph);
+
+	/*
+	 * Every Search on every Graph gets recorded here, until "ResetSearchTelemetry()".
+	 * Always empty in Shipping Builds.
+	 */
+	UFUNCTION(BlueprintPure, Category="Pathfinder|Stats")
+	static FBytesSearchTelemetry GetSearchTelemetry();
+
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Stats")
+	static void ResetSearchTelemetry();
+
+	// Logs Totals and Percentiles of the Search Telemetry
+	UFUNCTION(BlueprintCallable, Category="Pathfinder|Stats")
+	static void LogSearchTelemetry();
+
+	/*
+	 * Returns a new Graph
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
 	static FBytesGraph CreateGraph();
 
+	/*
+	 * Bakes the Graph into the binary Graph File Format (see "BytesGraphFile.h")
+	 * Returns false if the File could not be written
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	static bool SaveGraphToFile(const FBytesGraph& Graph, const FString& FilePath);
+
+	/*
+	 * Loads a baked Graph File into an editable Graph.
+	 * For read only Graphs use "FBytesMappedGraph" directly, it skips this Copy.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	static bool LoadGraphFromFile(const FString& FilePath, FBytesGraph& OutGraph);
+
 	/*
 	 * Creates a new "FBytesNode" and a "FBytesEdges"
 	 */
@@ -291,6 +1340,61 @@ class BYTESHEXGRIDPLUGIN_API UBytesPathfinder : public UBlueprintFunctionLibrary
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
 	static void AddOrSetEdge(UPARAM(ref) FBytesGraph& Graph, const int32 NodeAID, const int32 NodeBID, const int32 Weight);
+
+	/*
+	 * Creates or overrides a one way Edge From -> To. The Graph becomes directed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	static void AddOrSetDirectedEdge(UPARAM(ref) FBytesGraph& Graph, const int32 FromID, const int32 ToID, const int32 Weight);
+
+	/*
+	 * Creates or overrides both Directions with their own Weights, e.g. Uphill and Downhill
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	static void AddOrSetAsymmetricEdge(UPARAM(ref) FBytesGraph& Graph, const int32 NodeAID, const int32 NodeBID, const int32 WeightAB, const int32 WeightBA);
+
+	/*
+	 * Sets the Terrain Class Cost Profiles look up for every Edge leading into the Node
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	static void SetNodeTerrainClass(UPARAM(ref) FBytesGraph& Graph, const int32 NodeID, const uint8 TerrainClass);
+
+	/*
+	 * Removes the Edge in both Directions
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	static void RemoveEdge(UPARAM(ref) FBytesGraph& Graph, const int32 NodeAID, const int32 NodeBID);
+
+	/*
+	 * Removes only From -> To. The Graph becomes directed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	static void RemoveDirectedEdge(UPARAM(ref) FBytesGraph& Graph, const int32 FromID, const int32 ToID);
+
+	/*
+	 * Tombstones the Node in O(1), its ID stays reserved until "CompactGraph()".
+	 * Searches never enter removed Nodes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	static void RemoveNode(UPARAM(ref) FBytesGraph& Graph, const int32 NodeID);
+
+	/*
+	 * Drops all removed Nodes and their Edges and renumbers the remaining Nodes.
+	 * Returns the Remap Table: Remap[OldID] is the new ID, or -1 for removed Nodes.
+	 * Clears the Search State, as it refers to old ID's.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	static TArray<int32> CompactGraph(UPARAM(ref) FBytesGraph& Graph);
+
+	/*
+	 * Builds a whole Graph in one Pass. "AddOrSetEdge" scans the Edges of both Nodes on every Call, this sorts the Edges once,
+	 * so it is much faster on dense Graphs. On sparse Graphs like Grids both are about as fast.
+	 * Locations: one Entry per Node, the Index becomes the NodeID
+	 * FromIDs, ToIDs, Weights: one Entry per Edge. Duplicate Edges keep the last Weight.
+	 * bDirected: Edges only go From -> To, otherwise both Directions get the same Weight
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Graph")
+	static FBytesGraph BuildGraph(const TArray<FVector2D>& Locations, const TArray<int32>& FromIDs, const TArray<int32>& ToIDs, const TArray<int32>& Weights, const bool bDirected = false);
 	
 private:
 	// Linear Search Through an Array...
@@ -303,6 +1407,27 @@ private:
 
 	UFUNCTION()
 	static void InitNodes(FBytesGraph& Graph);
+
+	// Sets From -> To and keeps the Reverse Edges in Sync. Returns true if the Edge already existed
+	static bool SetDirectedEdge(FBytesGraph& Graph, const int32 FromID, const int32 ToID, const int32 Weight);
+
+	// Removes From -> To and its Reverse Edge. Returns false if there was no such Edge
+	static bool RemoveDirectedEdgeInternal(FBytesGraph& Graph, const int32 FromID, const int32 ToID);
+
+	// Switches an undirected Graph to directed by building the Reverse Edges once
+	static void MakeDirected(FBytesGraph& Graph);
+
+	// Adds the last Search of the Graph to the Search Telemetry
+	static void RecordSearch(const FBytesGraph& Graph);
+
+	// Recomputes the Components and the Heuristic Scale from all Edges between Nodes that are not removed
+	static void RebuildComponents(FBytesGraph& Graph);
+
+	// Cached Tree of the Source, runs Dijkstra if there is none. SourceID has to be valid
+	static const FBytesShortestPathTree& FindOrBuildTree(FBytesGraph& Graph, const int32 SourceID);
+
+	// Cached or new A* Path between two valid Nodes, Profile is optional
+	static TArray<int32> SearchPath(FBytesGraph& Graph, const int32 StartNodeID, const int32 TargetNodeID, const FBytesCostProfile* Profile);
 	
 };
 
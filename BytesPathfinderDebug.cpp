@@ -0,0 +1,2402 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#include "Pathfinding/BytesPathfinderDebug.h"
+#include "Pathfinding/BytesPathfinderSearch.h"
+#include "Pathfinding/BytesGridGraph.h"
+#include "Pathfinding/BytesMultiAgent.h"
+#include "Pathfinding/BytesPathfinderTrace.h"
+#include "Math/RandomStream.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	constexpr double CellSize = 100.0;
+
+	// MovingAI Grids, see "LoadMovingAIMap()"
+	constexpr int32 MovingAICellSize = 1000;
+	constexpr int32 MovingAIDiagonalCost = 1415;
+
+	bool IsMovingAIPassable(const TCHAR Cell)
+	{
+		return Cell == TEXT('.') || Cell == TEXT('G') || Cell == TEXT('S');
+	}
+
+	// Collects Edges for "UBytesPathfinder::BuildGraph()"
+	struct FEdgeList
+	{
+		TArray<int32> FromIDs;
+		TArray<int32> ToIDs;
+		TArray<int32> Weights;
+
+		void Add(const int32 FromID, const int32 ToID, const int32 Weight)
+		{
+			FromIDs.Add(FromID);
+			ToIDs.Add(ToID);
+			Weights.Add(Weight);
+		}
+	};
+
+	int32 CountEdges(const FBytesGraph& Graph)
+	{
+		int32 NumEdges = 0;
+		for (const FBytesEdges& NodeEdges : Graph.Edges)
+		{
+			NumEdges += NodeEdges.NeighbouringEdges.Num();
+		}
+		return NumEdges;
+	}
+
+	// Search State, Heap Items and Closed Bits of one Query on the Graph
+	int64 EstimateSearchBytes(const int32 NumNodes)
+	{
+		return int64(NumNodes) * (4 * sizeof(int32) + sizeof(int32)) + NumNodes / 8;
+	}
+
+	// Random small Graph for "ValidateSolvers()", covering every Edge Kind the Graph supports.
+	// Metric Weights never go below the Distance, so the Heuristic Scale stays 1 and A* gets a full Heuristic
+	FBytesGraph CreateValidationGraph(FRandomStream& Random, const bool bMetricWeights = false)
+	{
+		FBytesGraph Graph;
+
+		const int32 NumNodes = Random.RandRange(2, 60);
+		for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+		{
+			UBytesPathfinder::AddNode(Graph, FVector2D(Random.FRandRange(0.0f, 1000.0f), Random.FRandRange(0.0f, 1000.0f)));
+		}
+
+		const int32 NumEdges = Random.RandRange(0, NumNodes * 3);
+		for (int32 Index = 0; Index < NumEdges; Index++)
+		{
+			const int32 NodeAID = Random.RandRange(0, NumNodes - 1);
+			const int32 NodeBID = Random.RandRange(0, NumNodes - 1);
+
+			// Weights from far below to above the Distance, to break naive Heuristics
+			const int32 Distance = FMath::CeilToInt32(FVector2D::Distance(Graph.Nodes[NodeAID].Location2D, Graph.Nodes[NodeBID].Location2D));
+			const int32 MinWeight = bMetricWeights ? Distance : 0;
+			const int32 Weight = Random.RandRange(MinWeight, Distance * 2 + 10);
+
+			switch (Random.RandRange(0, 5))
+			{
+			case 0:
+				UBytesPathfinder::AddOrSetDirectedEdge(Graph, NodeAID, NodeBID, Weight);
+				break;
+			case 1:
+				UBytesPathfinder::AddOrSetAsymmetricEdge(Graph, NodeAID, NodeBID, Weight, Random.RandRange(MinWeight, Distance * 2 + 10));
+				break;
+			case 2:
+				UBytesPathfinder::RemoveEdge(Graph, NodeAID, NodeBID);
+				break;
+			default:
+				UBytesPathfinder::AddOrSetEdge(Graph, NodeAID, NodeBID, Weight);
+				break;
+			}
+		}
+
+		// Terrain for the Cost Profile Solvers
+		for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+		{
+			UBytesPathfinder::SetNodeTerrainClass(Graph, NodeID, Random.RandRange(0, 3));
+		}
+
+		// A few Tombstones, but always keep Node 0 alive
+		const int32 NumRemovals = Random.RandRange(0, NumNodes / 8);
+		for (int32 Index = 0; Index < NumRemovals; Index++)
+		{
+			const int32 NodeID = Random.RandRange(1, NumNodes - 1);
+			if (Graph.IsValidNode(NodeID))
+			{
+				UBytesPathfinder::RemoveNode(Graph, NodeID);
+			}
+		}
+
+		return Graph;
+	}
+
+	// Random Percentages for 4 Terrain Classes, some impassable
+	FBytesCostProfile CreateValidationProfile(FRandomStream& Random)
+	{
+		FBytesCostProfile Profile;
+		for (int32 TerrainClass = 0; TerrainClass < 4; TerrainClass++)
+		{
+			Profile.TerrainCostPercent.Add(Random.RandRange(0, 7) == 0 ? -1 : Random.RandRange(0, 300));
+		}
+		return Profile;
+	}
+
+	/*
+	 * Lowest Weight of any Edge From -> To, or -1. Edges into removed Nodes do not count.
+	 * With a Profile the Weight is scaled by the Terrain of ToID, rounded up, or -1 if it is impassable.
+	 */
+	int64 FindEdgeWeight(const FBytesGraph& Graph, const int32 FromID, const int32 ToID, const FBytesCostProfile* Profile)
+	{
+		int64 Weight = INDEX_NONE;
+		if (!Graph.IsValidNode(FromID) || !Graph.IsValidNode(ToID))
+		{
+			return Weight;
+		}
+
+		int64 Percent = 100;
+		if (Profile)
+		{
+			const uint8 TerrainClass = Graph.Nodes[ToID].TerrainClass;
+			Percent = Profile->TerrainCostPercent.IsValidIndex(TerrainClass) ? Profile->TerrainCostPercent[TerrainClass] : 100;
+			if (Percent < 0)
+			{
+				return Weight;
+			}
+		}
+
+		for (const FBytesEdge& Edge : Graph.Edges[FromID].NeighbouringEdges)
+		{
+			const int64 EdgeWeight = (Edge.Weight * Percent + 99) / 100;
+			if (Edge.NodeID == ToID && (Weight == INDEX_NONE || EdgeWeight < Weight))
+			{
+				Weight = EdgeWeight;
+			}
+		}
+		return Weight;
+	}
+
+	/*
+	 * Parents an any Angle Search left in State from TargetID back to StartID: every Step has to be an Edge
+	 * or a Line the Policy connects, each for exactly the GCost Difference.
+	 */
+	template<typename LineOfSightType, typename GraphType>
+	bool IsAnyAngleTreeValid(const GraphType& Graph, const LineOfSightType& LineOfSight, const FBytesSearchState& State, const int32 StartID, const int32 TargetID)
+	{
+		int32 NodeID = TargetID;
+		for (int32 NumSteps = 0; NodeID != StartID; NumSteps++)
+		{
+			const int32 ParentID = State.ParentID[NodeID];
+			if (ParentID == INDEX_NONE || NumSteps >= Graph.NumNodes())
+			{
+				return false;
+			}
+
+			const int32 StepCost = State.GCost[NodeID] - State.GCost[ParentID];
+			bool bEdge = false;
+			Graph.ForEachNeighbour(ParentID, [&bEdge, NodeID, StepCost](const int32 NeighbourID, const int32 Weight)
+			{
+				bEdge |= NeighbourID == NodeID && Weight == StepCost;
+			});
+
+			int32 LineCost;
+			if (!bEdge && !(LineOfSight(Graph, ParentID, NodeID, LineCost) && LineCost == StepCost))
+			{
+				return false;
+			}
+			NodeID = ParentID;
+		}
+		return State.GCost[StartID] == 0;
+	}
+
+	/*
+	 * A simplified Path has to keep the Target and a Subset of the Nodes in their Order.
+	 * Collinear Removal may only drop Nodes on the Line between their kept Neighbours,
+	 * String Pulling only Lines the Policy connects and never a more expensive Path.
+	 */
+	template<typename LineOfSightType, typename GraphType>
+	bool IsSimplifiedPathValid(const GraphType& Graph, const LineOfSightType& LineOfSight, const int32 StartID, const TArray<int32>& Path, const TArray<int32>& Simplified, const EBytesPathSimplification Simplification)
+	{
+		if (Path.IsEmpty() || Simplified.IsEmpty())
+		{
+			return Path.IsEmpty() && Simplified.IsEmpty();
+		}
+		if (Simplified.Last() != Path.Last())
+		{
+			return false;
+		}
+
+		int32 PathIndex = 0;
+		int32 PreviousID = StartID;
+		for (const int32 NodeID : Simplified)
+		{
+			const FVector2D From = Graph.GetLocation(PreviousID);
+			const FVector2D Line = Graph.GetLocation(NodeID) - From;
+			for (; PathIndex < Path.Num() && Path[PathIndex] != NodeID; PathIndex++)
+			{
+				const FVector2D Offset = Graph.GetLocation(Path[PathIndex]) - From;
+				const bool bOnLine = FMath::Abs(FVector2D::CrossProduct(Line, Offset)) <= 1e-6 * Line.SizeSquared() && FVector2D::DotProduct(Line, Offset) > 0.0 && Offset.SizeSquared() < Line.SizeSquared();
+				if (Simplification == EBytesPathSimplification::RemoveCollinear && !bOnLine)
+				{
+					return false;
+				}
+			}
+			if (PathIndex == Path.Num())
+			{
+				return false;
+			}
+
+			if (Simplification == EBytesPathSimplification::PullString && BytesSearch::GetStepCost(Graph, LineOfSight, PreviousID, NodeID) == INITIAL_DISTANCE)
+			{
+				return false;
+			}
+			PreviousID = NodeID;
+			PathIndex++;
+		}
+
+		return Simplification != EBytesPathSimplification::PullString
+			|| BytesSearch::GetPathCost(Graph, LineOfSight, StartID, Simplified) <= BytesSearch::GetPathCost(Graph, LineOfSight, StartID, Path);
+	}
+
+	// Cost of a Path in the "GetPath()" Format (Start excluded), or -1 if it uses an Edge that does not exist
+	int64 MeasurePath(const FBytesGraph& Graph, const int32 StartID, const TArray<int32>& Path, const FBytesCostProfile* Profile)
+	{
+		int64 Cost = 0;
+		int32 PreviousID = StartID;
+		for (const int32 NodeID : Path)
+		{
+			const int64 Weight = FindEdgeWeight(Graph, PreviousID, NodeID, Profile);
+			if (Weight == INDEX_NONE)
+			{
+				return INDEX_NONE;
+			}
+			Cost += Weight;
+			PreviousID = NodeID;
+		}
+		return Cost;
+	}
+
+	/*
+	 * Reference Dijkstra: no Heap, no Heuristic, no shared Code with the Solvers.
+	 * Picks the cheapest unvisited Node by linear Search. Returns -1 for unreachable Nodes.
+	 */
+	TArray<int64> ReferenceDijkstra(const FBytesGraph& Graph, const int32 StartID, const FBytesCostProfile* Profile)
+	{
+		const int32 NumNodes = Graph.Nodes.Num();
+		TArray<int64> Costs;
+		Costs.Init(INDEX_NONE, NumNodes);
+		TBitArray<> Visited(false, NumNodes);
+
+		Costs[StartID] = 0;
+		while (true)
+		{
+			int32 CurrentID = INDEX_NONE;
+			for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+			{
+				if (!Visited[NodeID] && Costs[NodeID] != INDEX_NONE && (CurrentID == INDEX_NONE || Costs[NodeID] < Costs[CurrentID]))
+				{
+					CurrentID = NodeID;
+				}
+			}
+
+			if (CurrentID == INDEX_NONE)
+			{
+				return Costs;
+			}
+			Visited[CurrentID] = true;
+
+			for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+			{
+				const int64 Weight = FindEdgeWeight(Graph, CurrentID, NodeID, Profile);
+				if (Weight != INDEX_NONE && (Costs[NodeID] == INDEX_NONE || Costs[CurrentID] + Weight < Costs[NodeID]))
+				{
+					Costs[NodeID] = Costs[CurrentID] + Weight;
+				}
+			}
+		}
+	}
+
+	/*
+	 * Reference for Conflict Based Search: Dijkstra over the joint State of all Agents, one Node each plus whether it is done.
+	 * Every Turn each Agent waits, steps over an Edge or, on its Target, gets done and stays there for free.
+	 * Returns the lowest Sum of Costs, -1 if the Agents can not all get done. Only for a few Agents on tiny Graphs.
+	 */
+	int64 ReferenceJointCost(const FBytesGraph& Graph, const TArray<FBytesAgentRequest>& Agents, const int64 WaitCost)
+	{
+		const int32 NumAgents = Agents.Num();
+		const uint64 NumNodes = Graph.Nodes.Num();
+		const uint64 DoneMask = (uint64(1) << NumAgents) - 1;
+
+		// Positions in Base NumNodes, the Done Bits below
+		const auto Encode = [&](const TArray<int32>& Positions, const uint64 Done)
+		{
+			uint64 Key = 0;
+			for (int32 AgentID = NumAgents - 1; AgentID >= 0; AgentID--)
+			{
+				Key = Key * NumNodes + Positions[AgentID];
+			}
+			return (Key << NumAgents) | Done;
+		};
+
+		struct FOption
+		{
+			int32 NodeID;
+			int64 Cost;
+			bool bDone;
+		};
+
+		TMap<uint64, int64> Costs;
+		TSet<uint64> Visited;
+		TArray<TPair<int64, uint64>> OpenSet;
+		const auto IsCheaper = [](const TPair<int64, uint64>& A, const TPair<int64, uint64>& B) { return A.Key < B.Key; };
+
+		TArray<int32> Positions;
+		for (const FBytesAgentRequest& Agent : Agents)
+		{
+			Positions.Add(Agent.StartID);
+		}
+		Costs.Add(Encode(Positions, 0), 0);
+		OpenSet.HeapPush({0, Encode(Positions, 0)}, IsCheaper);
+
+		while (!OpenSet.IsEmpty())
+		{
+			TPair<int64, uint64> Entry;
+			OpenSet.HeapPop(Entry, IsCheaper);
+			bool bVisited = false;
+			Visited.Add(Entry.Value, &bVisited);
+			if (bVisited)
+			{
+				continue;
+			}
+
+			const uint64 Done = Entry.Value & DoneMask;
+			if (Done == DoneMask)
+			{
+				return Entry.Key;
+			}
+			uint64 Rest = Entry.Value >> NumAgents;
+			for (int32 AgentID = 0; AgentID < NumAgents; AgentID++)
+			{
+				Positions[AgentID] = int32(Rest % NumNodes);
+				Rest /= NumNodes;
+			}
+
+			TArray<TArray<FOption>> Options;
+			for (int32 AgentID = 0; AgentID < NumAgents; AgentID++)
+			{
+				TArray<FOption>& AgentOptions = Options.AddDefaulted_GetRef();
+				const int32 NodeID = Positions[AgentID];
+				if (Done & (uint64(1) << AgentID))
+				{
+					AgentOptions.Add({NodeID, 0, true});
+					continue;
+				}
+				AgentOptions.Add({NodeID, WaitCost, false});
+				if (NodeID == Agents[AgentID].TargetID)
+				{
+					AgentOptions.Add({NodeID, 0, true});
+				}
+				for (int32 NeighbourID = 0; NeighbourID < int32(NumNodes); NeighbourID++)
+				{
+					const int64 Weight = NeighbourID != NodeID ? FindEdgeWeight(Graph, NodeID, NeighbourID, nullptr) : INDEX_NONE;
+					if (Weight != INDEX_NONE)
+					{
+						AgentOptions.Add({NeighbourID, Weight, false});
+					}
+				}
+			}
+
+			// Every Combination of Options, counted like an Odometer
+			TArray<int32> Choices;
+			Choices.Init(0, NumAgents);
+			while (true)
+			{
+				TArray<int32> NextPositions;
+				uint64 NextDone = 0;
+				int64 Cost = Entry.Key;
+				bool bValid = true;
+				for (int32 AgentID = 0; AgentID < NumAgents; AgentID++)
+				{
+					const FOption& Option = Options[AgentID][Choices[AgentID]];
+					for (int32 OtherID = 0; OtherID < AgentID; OtherID++)
+					{
+						const bool bSwap = Option.NodeID == Positions[OtherID] && NextPositions[OtherID] == Positions[AgentID] && Option.NodeID != Positions[AgentID];
+						bValid &= Option.NodeID != NextPositions[OtherID] && !bSwap;
+					}
+					NextPositions.Add(Option.NodeID);
+					NextDone |= uint64(Option.bDone) << AgentID;
+					Cost += Option.Cost;
+				}
+
+				const uint64 NextKey = Encode(NextPositions, NextDone);
+				int64& NextCost = Costs.FindOrAdd(NextKey, MAX_int64);
+				if (bValid && Cost < NextCost)
+				{
+					NextCost = Cost;
+					OpenSet.HeapPush({Cost, NextKey}, IsCheaper);
+				}
+
+				int32 AgentID = 0;
+				while (AgentID < NumAgents && ++Choices[AgentID] == Options[AgentID].Num())
+				{
+					Choices[AgentID++] = 0;
+				}
+				if (AgentID == NumAgents)
+				{
+					break;
+				}
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	FBytesBenchmarkResult MakeResult(const FBytesGraph& Graph, const FString& GraphName, const TCHAR* EntryPoint, const int32 NumQueries, const double Seconds)
+	{
+		FBytesBenchmarkResult Result;
+		Result.Name = GraphName + TEXT(" / ") + EntryPoint;
+		Result.NumNodes = Graph.Nodes.Num();
+		Result.NumEdges = CountEdges(Graph);
+		Result.NumQueries = NumQueries;
+		Result.TotalSeconds = Seconds;
+		Result.MicrosecondsPerQuery = NumQueries > 0 ? Seconds * 1000000.0 / NumQueries : 0.0;
+		Result.GraphBytes = Graph.GetAllocatedSize();
+		Result.SearchBytes = EstimateSearchBytes(Graph.Nodes.Num());
+		return Result;
+	}
+
+	// Implicit Grids store no Edges, only their Cells count
+	FBytesBenchmarkResult MakeGridResult(const FBytesGridGraph& Grid, const FString& GridName, const TCHAR* EntryPoint, const int32 NumQueries, const double Seconds)
+	{
+		FBytesBenchmarkResult Result;
+		Result.Name = GridName + TEXT(" / ") + EntryPoint;
+		Result.NumNodes = Grid.NumNodes();
+		Result.NumQueries = NumQueries;
+		Result.TotalSeconds = Seconds;
+		Result.MicrosecondsPerQuery = NumQueries > 0 ? Seconds * 1000000.0 / NumQueries : 0.0;
+		Result.GraphBytes = Grid.GetAllocatedSize();
+		Result.SearchBytes = EstimateSearchBytes(Grid.NumNodes());
+		return Result;
+	}
+
+	// Blocks about BlockedChance of all Cells, the Rest costs between MinCost and MaxCost
+	void ScatterGridCells(FBytesGridGraph& Grid, FRandomStream& Random, const float BlockedChance, const int32 MinCost, const int32 MaxCost)
+	{
+		for (int32 NodeID = 0; NodeID < Grid.NumNodes(); NodeID++)
+		{
+			Grid.SetCellCost(NodeID, Random.FRand() < BlockedChance ? 0 : uint8(Random.RandRange(MinCost, MaxCost)));
+		}
+	}
+
+	// Random passable Cell, or -1 if there seems to be none
+	int32 GetRandomPassableCell(const FBytesGridGraph& Grid, FRandomStream& Random)
+	{
+		for (int32 Attempt = 0; Attempt < 64; Attempt++)
+		{
+			const int32 NodeID = Random.RandRange(0, Grid.NumNodes() - 1);
+			if (Grid.IsPassable(NodeID))
+			{
+				return NodeID;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	/*
+	 * Reference Line of Sight on Square Grids: the Segment between both Cell Centers must not touch any blocked Cell,
+	 * Borders and Corners included. Tests every Cell of the Bounding Box, so only for small Grids
+	 */
+	bool ReferenceLineOfSight(const FBytesGridGraph& Grid, const FIntPoint From, const FIntPoint To)
+	{
+		// Half Cells, so Centers are odd and Borders even
+		const int64 AX = 2 * From.X + 1;
+		const int64 AY = 2 * From.Y + 1;
+		const int64 BX = 2 * To.X + 1;
+		const int64 BY = 2 * To.Y + 1;
+
+		for (int32 Y = FMath::Min(From.Y, To.Y); Y <= FMath::Max(From.Y, To.Y); Y++)
+		{
+			for (int32 X = FMath::Min(From.X, To.X); X <= FMath::Max(From.X, To.X); X++)
+			{
+				if (Grid.IsWalkable(X, Y))
+				{
+					continue;
+				}
+
+				// The Segment misses the Cell only if every Corner lies strictly on the same Side
+				int32 NumLeft = 0;
+				int32 NumRight = 0;
+				for (const FIntPoint Corner : {FIntPoint(0, 0), FIntPoint(2, 0), FIntPoint(0, 2), FIntPoint(2, 2)})
+				{
+					const int64 Cross = (BX - AX) * (2 * Y + Corner.Y - AY) - (BY - AY) * (2 * X + Corner.X - AX);
+					NumLeft += Cross > 0;
+					NumRight += Cross < 0;
+				}
+				if (NumLeft != 4 && NumRight != 4)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	const TCHAR* GetConnectivityName(const EBytesGridConnectivity Connectivity)
+	{
+		switch (Connectivity)
+		{
+		case EBytesGridConnectivity::Four:
+			return TEXT("Grid4");
+		case EBytesGridConnectivity::Eight:
+			return TEXT("Grid8");
+		case EBytesGridConnectivity::Hex:
+			return TEXT("Hex6");
+		}
+		return TEXT("Grid");
+	}
+}
+
+FBytesGraph UBytesPathfinderDebug::CreateSquareGridGraph(const int32 Width, const int32 Height, const bool bDiagonal)
+{
+	TArray<FVector2D> Locations;
+	Locations.Reserve(Width * Height);
+	for (int32 Y = 0; Y < Height; Y++)
+	{
+		for (int32 X = 0; X < Width; X++)
+		{
+			Locations.Add(FVector2D(X * CellSize, Y * CellSize));
+		}
+	}
+
+	// Every Edge gets added once, from the Cell with the lower ID
+	FEdgeList EdgeList;
+	for (int32 Y = 0; Y < Height; Y++)
+	{
+		for (int32 X = 0; X < Width; X++)
+		{
+			const int32 NodeID = Y * Width + X;
+			if (X + 1 < Width)
+			{
+				EdgeList.Add(NodeID, NodeID + 1, 100);
+			}
+			if (Y + 1 < Height)
+			{
+				EdgeList.Add(NodeID, NodeID + Width, 100);
+			}
+			if (bDiagonal && Y + 1 < Height && X + 1 < Width)
+			{
+				EdgeList.Add(NodeID, NodeID + Width + 1, 142);
+			}
+			if (bDiagonal && Y + 1 < Height && X > 0)
+			{
+				EdgeList.Add(NodeID, NodeID + Width - 1, 142);
+			}
+		}
+	}
+
+	FBytesGraph Graph = UBytesPathfinder::BuildGraph(Locations, EdgeList.FromIDs, EdgeList.ToIDs, EdgeList.Weights);
+	Graph.GraphType = EBytesGraphType::Square;
+	return Graph;
+}
+
+FBytesGraph UBytesPathfinderDebug::CreateHexGridGraph(const int32 Width, const int32 Height)
+{
+	// Odd Rows are shifted half a Cell to the right
+	TArray<FVector2D> Locations;
+	Locations.Reserve(Width * Height);
+	for (int32 Row = 0; Row < Height; Row++)
+	{
+		for (int32 Column = 0; Column < Width; Column++)
+		{
+			Locations.Add(FVector2D((Column + 0.5 * (Row & 1)) * CellSize, Row * CellSize * FMath::Sqrt(3.0) * 0.5));
+		}
+	}
+
+	// Every Edge gets added once: right, lower left and lower right Neighbour
+	FEdgeList EdgeList;
+	for (int32 Row = 0; Row < Height; Row++)
+	{
+		const int32 LowerLeftColumnOffset = (Row & 1) ? 0 : -1;
+		for (int32 Column = 0; Column < Width; Column++)
+		{
+			const int32 NodeID = Row * Width + Column;
+			if (Column + 1 < Width)
+			{
+				EdgeList.Add(NodeID, NodeID + 1, 100);
+			}
+			if (Row + 1 >= Height)
+			{
+				continue;
+			}
+
+			const int32 LowerLeftColumn = Column + LowerLeftColumnOffset;
+			if (LowerLeftColumn >= 0)
+			{
+				EdgeList.Add(NodeID, (Row + 1) * Width + LowerLeftColumn, 100);
+			}
+			if (LowerLeftColumn + 1 < Width)
+			{
+				EdgeList.Add(NodeID, (Row + 1) * Width + LowerLeftColumn + 1, 100);
+			}
+		}
+	}
+
+	FBytesGraph Graph = UBytesPathfinder::BuildGraph(Locations, EdgeList.FromIDs, EdgeList.ToIDs, EdgeList.Weights);
+	Graph.GraphType = EBytesGraphType::Hexagonal;
+	return Graph;
+}
+
+FBytesGraph UBytesPathfinderDebug::CreateRandomGeometricGraph(const int32 NumNodes, const float AverageDegree, const int32 Seed)
+{
+	FRandomStream Random(Seed);
+
+	// Points are spread with a Density of one Point per CellSize * CellSize
+	const double Side = FMath::Sqrt(double(FMath::Max(NumNodes, 1))) * CellSize;
+	const double Radius = CellSize * FMath::Sqrt(FMath::Max(AverageDegree, 1.0f) / UE_PI);
+
+	TArray<FVector2D> Locations;
+	Locations.Reserve(NumNodes);
+	for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+	{
+		Locations.Add(FVector2D(Random.FRand() * Side, Random.FRand() * Side));
+	}
+
+	// Bucket Points into Cells of the Radius, so only the 3x3 surrounding Buckets need to be checked
+	const int32 BucketsPerSide = FMath::Max(1, FMath::FloorToInt32(Side / Radius));
+	auto GetBucketCoordinate = [BucketsPerSide, Side](const double Coordinate)
+	{
+		return FMath::Clamp(FMath::FloorToInt32(Coordinate / Side * BucketsPerSide), 0, BucketsPerSide - 1);
+	};
+
+	TArray<TArray<int32>> Buckets;
+	Buckets.SetNum(BucketsPerSide * BucketsPerSide);
+	for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+	{
+		Buckets[GetBucketCoordinate(Locations[NodeID].Y) * BucketsPerSide + GetBucketCoordinate(Locations[NodeID].X)].Add(NodeID);
+	}
+
+	FEdgeList EdgeList;
+	for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+	{
+		const int32 BucketX = GetBucketCoordinate(Locations[NodeID].X);
+		const int32 BucketY = GetBucketCoordinate(Locations[NodeID].Y);
+		for (int32 Y = FMath::Max(BucketY - 1, 0); Y <= FMath::Min(BucketY + 1, BucketsPerSide - 1); Y++)
+		{
+			for (int32 X = FMath::Max(BucketX - 1, 0); X <= FMath::Min(BucketX + 1, BucketsPerSide - 1); X++)
+			{
+				for (const int32 OtherID : Buckets[Y * BucketsPerSide + X])
+				{
+					// Every Pair once
+					if (OtherID <= NodeID)
+					{
+						continue;
+					}
+
+					const double Distance = FVector2D::Distance(Locations[NodeID], Locations[OtherID]);
+					if (Distance <= Radius)
+					{
+						EdgeList.Add(NodeID, OtherID, FMath::Max(1, FMath::CeilToInt32(Distance)));
+					}
+				}
+			}
+		}
+	}
+
+	return UBytesPathfinder::BuildGraph(Locations, EdgeList.FromIDs, EdgeList.ToIDs, EdgeList.Weights);
+}
+
+FBytesGraph UBytesPathfinderDebug::CreateRoadGraph(const int32 NumNodes, const int32 Seed)
+{
+	constexpr int32 HighwaySpacing = 8;
+	constexpr float LocalRoadChance = 0.7f;
+
+	FRandomStream Random(Seed);
+	const int32 Side = FMath::Max(1, FMath::FloorToInt32(FMath::Sqrt(double(NumNodes))));
+
+	TArray<FVector2D> Locations;
+	Locations.Reserve(Side * Side);
+	for (int32 Y = 0; Y < Side; Y++)
+	{
+		for (int32 X = 0; X < Side; X++)
+		{
+			const FVector2D Jitter(Random.FRandRange(-0.3f, 0.3f), Random.FRandRange(-0.3f, 0.3f));
+			Locations.Add((FVector2D(X, Y) + Jitter) * CellSize);
+		}
+	}
+
+	FEdgeList EdgeList;
+	auto AddRoad = [&EdgeList, &Locations](const int32 FromID, const int32 ToID, const double CostPerUnit)
+	{
+		const double Distance = FVector2D::Distance(Locations[FromID], Locations[ToID]);
+		EdgeList.Add(FromID, ToID, FMath::Max(1, FMath::CeilToInt32(Distance * CostPerUnit)));
+	};
+
+	for (int32 Y = 0; Y < Side; Y++)
+	{
+		for (int32 X = 0; X < Side; X++)
+		{
+			const int32 NodeID = Y * Side + X;
+
+			// Local Roads, slow and not everywhere
+			if (X + 1 < Side && Random.FRand() < LocalRoadChance)
+			{
+				AddRoad(NodeID, NodeID + 1, 1.5);
+			}
+			if (Y + 1 < Side && Random.FRand() < LocalRoadChance)
+			{
+				AddRoad(NodeID, NodeID + Side, 1.5);
+			}
+
+			// Highways jump to the next Junction
+			if (Y % HighwaySpacing == 0 && X % HighwaySpacing == 0)
+			{
+				if (X + HighwaySpacing < Side)
+				{
+					AddRoad(NodeID, NodeID + HighwaySpacing, 1.0);
+				}
+				if (Y + HighwaySpacing < Side)
+				{
+					AddRoad(NodeID, NodeID + HighwaySpacing * Side, 1.0);
+				}
+			}
+		}
+	}
+
+	return UBytesPathfinder::BuildGraph(Locations, EdgeList.FromIDs, EdgeList.ToIDs, EdgeList.Weights);
+}
+
+FBytesGraph UBytesPathfinderDebug::CreateBenchmarkGraph(const EBytesBenchmarkGraph GraphKind, const int32 NumNodes, const int32 Seed)
+{
+	const int32 Side = FMath::Max(1, FMath::FloorToInt32(FMath::Sqrt(double(NumNodes))));
+
+	switch (GraphKind)
+	{
+	case EBytesBenchmarkGraph::Square:
+		return CreateSquareGridGraph(Side, Side, true);
+	case EBytesBenchmarkGraph::Hexagonal:
+		return CreateHexGridGraph(Side, Side);
+	case EBytesBenchmarkGraph::RandomGeometric:
+		return CreateRandomGeometricGraph(NumNodes, 8.0f, Seed);
+	case EBytesBenchmarkGraph::Road:
+		return CreateRoadGraph(NumNodes, Seed);
+	}
+
+	return FBytesGraph();
+}
+
+TArray<FBytesBenchmarkResult> UBytesPathfinderDebug::RunBenchmarks(const FBytesGraph& Graph, const FString& GraphName, const int32 NumQueries, const int32 Seed)
+{
+	TArray<FBytesBenchmarkResult> Results;
+
+	const int32 NumNodes = Graph.Nodes.Num();
+	if (NumNodes == 0 || NumQueries <= 0)
+	{
+		return Results;
+	}
+
+	// Same Queries for every Entry Point
+	FRandomStream Random(Seed);
+	TArray<int32> StartIDs;
+	TArray<int32> TargetIDs;
+	for (int32 Query = 0; Query < NumQueries; Query++)
+	{
+		StartIDs.Add(Random.RandRange(0, NumNodes - 1));
+		TargetIDs.Add(Random.RandRange(0, NumNodes - 1));
+	}
+
+	// Searches run on a Copy, so the Search State of the Caller stays untouched.
+	// Every Row goes through the public Entry Point and sums its "LastSearchStats", which only Searches reset
+	FBytesGraph WorkGraph = Graph;
+	const EBytesSearchQueue SearchQueue = WorkGraph.SearchQueue;
+
+	// ==== Sub Section | FindPath ==== //
+	for (const EBytesSearchQueue Queue : {EBytesSearchQueue::IndexedHeap, EBytesSearchQueue::LazyHeap})
+	{
+		UBytesPathfinder::SetSearchQueue(WorkGraph, Queue);
+		FBytesSearchStats Stats;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Query = 0; Query < NumQueries; Query++)
+		{
+			UBytesPathfinder::FindPath(WorkGraph, StartIDs[Query], TargetIDs[Query]);
+			Stats += WorkGraph.LastSearchStats;
+		}
+		const TCHAR* EntryPoint = Queue == EBytesSearchQueue::LazyHeap ? TEXT("FindPath (Lazy Heap)") : TEXT("FindPath");
+		FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeResult(WorkGraph, GraphName, EntryPoint, NumQueries, FPlatformTime::Seconds() - StartTime));
+		Result.Stats = Stats;
+	}
+	UBytesPathfinder::SetSearchQueue(WorkGraph, SearchQueue);
+
+	// ==== Sub Section | GetPath ==== //
+	// Component Check, Path Cache, sparse State and Simplification as set on the Graph
+	{
+		FBytesSearchStats Stats;
+		int64 PathNodes = 0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Query = 0; Query < NumQueries; Query++)
+		{
+			WorkGraph.LastSearchStats = FBytesSearchStats();
+			PathNodes += UBytesPathfinder::GetPath(WorkGraph, StartIDs[Query], TargetIDs[Query], true).Num();
+			Stats += WorkGraph.LastSearchStats;
+		}
+		FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeResult(WorkGraph, GraphName, TEXT("GetPath"), NumQueries, FPlatformTime::Seconds() - StartTime));
+		Result.Stats = Stats;
+		Result.SearchBytes += PathNodes / NumQueries * sizeof(int32);
+	}
+
+	// ==== Sub Section | FindPathsToNodes and GetNodesInRange ==== //
+	// Full Dijkstra is much more expensive, so it gets fewer Queries
+	const int32 NumDijkstraQueries = FMath::Max(1, NumQueries / 10);
+	for (const EBytesSearchQueue Queue : {EBytesSearchQueue::IndexedHeap, EBytesSearchQueue::LazyHeap})
+	{
+		UBytesPathfinder::SetSearchQueue(WorkGraph, Queue);
+		const bool bLazyHeap = Queue == EBytesSearchQueue::LazyHeap;
+		FBytesSearchStats Stats;
+		double RangeSeconds = 0.0;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Query = 0; Query < NumDijkstraQueries; Query++)
+		{
+			UBytesPathfinder::FindPathsToNodes(WorkGraph, StartIDs[Query]);
+			Stats += WorkGraph.LastSearchStats;
+
+			// Range is the Cost to the Target, so the Result Size varies with the Query. Once is enough
+			if (!bLazyHeap)
+			{
+				const double RangeStartTime = FPlatformTime::Seconds();
+				UBytesPathfinder::GetNodesInRange(WorkGraph, WorkGraph.SearchState.GCost[TargetIDs[Query]]);
+				RangeSeconds += FPlatformTime::Seconds() - RangeStartTime;
+			}
+		}
+		const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+		FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeResult(WorkGraph, GraphName, bLazyHeap ? TEXT("FindPathsToNodes (Lazy Heap)") : TEXT("FindPathsToNodes"),
+			NumDijkstraQueries, TotalSeconds - RangeSeconds));
+		Result.Stats = Stats;
+		if (!bLazyHeap)
+		{
+			Results.Add(MakeResult(WorkGraph, GraphName, TEXT("GetNodesInRange"), NumDijkstraQueries, RangeSeconds));
+		}
+	}
+	UBytesPathfinder::SetSearchQueue(WorkGraph, SearchQueue);
+
+	// ==== Sub Section | Import ==== //
+	// The Edges of the Graph, once through "BuildGraph()" and once Edge by Edge like a Loader without it.
+	// Undirected Edges are listed once, both Ways set both Directions
+	{
+		TArray<FVector2D> Locations;
+		Locations.Reserve(NumNodes);
+		FEdgeList EdgeList;
+		for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+		{
+			Locations.Add(Graph.Nodes[NodeID].Location2D);
+			for (const FBytesEdge& Edge : Graph.Edges[NodeID].NeighbouringEdges)
+			{
+				if (Graph.bDirected || NodeID < Edge.NodeID)
+				{
+					EdgeList.Add(NodeID, Edge.NodeID, Edge.Weight);
+				}
+			}
+		}
+		const int32 NumImportEdges = EdgeList.FromIDs.Num();
+
+		double StartTime = FPlatformTime::Seconds();
+		const FBytesGraph BuiltGraph = UBytesPathfinder::BuildGraph(Locations, EdgeList.FromIDs, EdgeList.ToIDs, EdgeList.Weights, Graph.bDirected);
+		FBytesBenchmarkResult& BuildResult = Results.Add_GetRef(MakeResult(BuiltGraph, GraphName, TEXT("Import (BuildGraph)"), NumImportEdges, FPlatformTime::Seconds() - StartTime));
+		BuildResult.SearchBytes = 0;
+
+		StartTime = FPlatformTime::Seconds();
+		FBytesGraph AddedGraph;
+		for (const FVector2D& Location : Locations)
+		{
+			UBytesPathfinder::AddNode(AddedGraph, Location);
+		}
+		for (int32 EdgeIndex = 0; EdgeIndex < NumImportEdges; EdgeIndex++)
+		{
+			if (Graph.bDirected)
+			{
+				UBytesPathfinder::AddOrSetDirectedEdge(AddedGraph, EdgeList.FromIDs[EdgeIndex], EdgeList.ToIDs[EdgeIndex], EdgeList.Weights[EdgeIndex]);
+			}
+			else
+			{
+				UBytesPathfinder::AddOrSetEdge(AddedGraph, EdgeList.FromIDs[EdgeIndex], EdgeList.ToIDs[EdgeIndex], EdgeList.Weights[EdgeIndex]);
+			}
+		}
+		FBytesBenchmarkResult& AddResult = Results.Add_GetRef(MakeResult(AddedGraph, GraphName, TEXT("Import (AddNode + AddOrSetEdge)"), NumImportEdges, FPlatformTime::Seconds() - StartTime));
+		AddResult.SearchBytes = 0;
+	}
+
+	// ==== Sub Section | AddOrSetEdge ==== //
+	// Only new Edges between valid Nodes. Self Loops, Duplicates and existing Edges are dropped up front,
+	// their Warnings would be timed as well
+	{
+		TArray<int32> EdgeStartIDs;
+		TArray<int32> EdgeTargetIDs;
+		TSet<uint64> AddedEdges;
+		for (int32 Query = 0; Query < NumQueries; Query++)
+		{
+			const int32 NodeAID = FMath::Min(StartIDs[Query], TargetIDs[Query]);
+			const int32 NodeBID = FMath::Max(StartIDs[Query], TargetIDs[Query]);
+			if (NodeAID == NodeBID || !WorkGraph.IsValidNode(NodeAID) || !WorkGraph.IsValidNode(NodeBID) || FindEdgeWeight(WorkGraph, NodeAID, NodeBID, nullptr) != INDEX_NONE)
+			{
+				continue;
+			}
+
+			bool bAlreadyAdded = false;
+			AddedEdges.Add(uint64(NodeAID) << 32 | uint64(NodeBID), &bAlreadyAdded);
+			if (!bAlreadyAdded)
+			{
+				EdgeStartIDs.Add(NodeAID);
+				EdgeTargetIDs.Add(NodeBID);
+			}
+		}
+		if (EdgeStartIDs.Num() < NumQueries)
+		{
+			UE_LOG(LogTemp, Display, TEXT("Benchmark: AddOrSetEdge skipped %d of %d Pairs that were Self Loops, removed or already connected"), NumQueries - EdgeStartIDs.Num(), NumQueries);
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Query = 0; Query < EdgeStartIDs.Num(); Query++)
+		{
+			UBytesPathfinder::AddOrSetEdge(WorkGraph, EdgeStartIDs[Query], EdgeTargetIDs[Query], 1000);
+		}
+		FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeResult(Graph, GraphName, TEXT("AddOrSetEdge"), EdgeStartIDs.Num(), FPlatformTime::Seconds() - StartTime));
+		Result.SearchBytes = 0;
+	}
+
+	return Results;
+}
+
+TArray<FBytesBenchmarkResult> UBytesPathfinderDebug::RunBenchmarkSuite(const TArray<int32>& NodeCounts, const int32 NumQueries, const int32 Seed)
+{
+	static const TPair<EBytesBenchmarkGraph, const TCHAR*> GraphKinds[] =
+	{
+		{EBytesBenchmarkGraph::Square, TEXT("Square")},
+		{EBytesBenchmarkGraph::Hexagonal, TEXT("Hexagonal")},
+		{EBytesBenchmarkGraph::RandomGeometric, TEXT("RandomGeometric")},
+		{EBytesBenchmarkGraph::Road, TEXT("Road")},
+	};
+
+	TArray<FBytesBenchmarkResult> Results;
+	for (const int32 NodeCount : NodeCounts)
+	{
+		for (const auto& GraphKind : GraphKinds)
+		{
+			const FBytesGraph Graph = CreateBenchmarkGraph(GraphKind.Key, NodeCount, Seed);
+			const FString GraphName = FString::Printf(TEXT("%s %d"), GraphKind.Value, Graph.Nodes.Num());
+			Results.Append(RunBenchmarks(Graph, GraphName, NumQueries, Seed));
+		}
+	}
+
+	LogBenchmarkResults(Results);
+	return Results;
+}
+
+void UBytesPathfinderDebug::LogBenchmarkResults(const TArray<FBytesBenchmarkResult>& Results)
+{
+	UE_LOG(LogTemp, Display, TEXT("%-40s %10s %10s %8s %12s %14s %14s %14s %14s %14s %10s %10s %10s %12s %14s %10s %8s %8s %14s"),
+		TEXT("Benchmark"), TEXT("Nodes"), TEXT("Edges"), TEXT("Queries"), TEXT("us/Query"),
+		TEXT("Expanded"), TEXT("Generated"), TEXT("Pushes"), TEXT("Pops"), TEXT("Updates"), TEXT("Peak Open"), TEXT("B/Node"), TEXT("Search B/N"),
+		TEXT("LOS Checks"), TEXT("Path Cost"), TEXT("Path Nodes"), TEXT("Agents"), TEXT("Solved"), TEXT("Sum of Costs"));
+
+	for (const FBytesBenchmarkResult& Result : Results)
+	{
+		const double NodeDivisor = FMath::Max(Result.NumNodes, 1);
+		UE_LOG(LogTemp, Display, TEXT("%-40s %10d %10d %8d %12.2f %14lld %14lld %14lld %14lld %14lld %10lld %10.1f %10.1f %12lld %14lld %10lld %8lld %8lld %14lld"),
+			*Result.Name, Result.NumNodes, Result.NumEdges, Result.NumQueries, Result.MicrosecondsPerQuery,
+			Result.Stats.NodesExpanded, Result.Stats.NodesGenerated, Result.Stats.HeapPushes, Result.Stats.HeapPops, Result.Stats.HeapUpdates,
+			Result.Stats.PeakOpenSetSize, Result.GraphBytes / NodeDivisor, Result.SearchBytes / NodeDivisor,
+			Result.Stats.LineOfSightChecks, Result.PathCost, Result.PathNodes, Result.NumAgents, Result.NumSolved, Result.SumOfCosts);
+	}
+}
+
+bool UBytesPathfinderDebug::LoadMovingAIMap(const FString& MapFilePath, FBytesGraph& OutGraph, TArray<int32>& OutCellToNode, int32& OutWidth, int32& OutHeight)
+{
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *MapFilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MovingAI: Could not read %s"), *MapFilePath);
+		return false;
+	}
+
+	// ==== Sub Section | Header ==== //
+
+	OutWidth = 0;
+	OutHeight = 0;
+	int32 LineIndex = 0;
+	for (; LineIndex < Lines.Num(); LineIndex++)
+	{
+		TArray<FString> Tokens;
+		Lines[LineIndex].ParseIntoArrayWS(Tokens);
+		if (Tokens.Num() == 1 && Tokens[0] == TEXT("map"))
+		{
+			LineIndex++;
+			break;
+		}
+		if (Tokens.Num() == 2 && Tokens[0] == TEXT("height"))
+		{
+			LexFromString(OutHeight, *Tokens[1]);
+		}
+		if (Tokens.Num() == 2 && Tokens[0] == TEXT("width"))
+		{
+			LexFromString(OutWidth, *Tokens[1]);
+		}
+	}
+
+	if (OutWidth <= 0 || OutHeight <= 0 || Lines.Num() - LineIndex < OutHeight)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MovingAI: %s has an invalid Header"), *MapFilePath);
+		return false;
+	}
+
+	// ==== Sub Section | Cells ==== //
+
+	const int32 Width = OutWidth;
+	const int32 Height = OutHeight;
+	auto IsPassable = [&Lines, LineIndex, Width, Height](const int32 X, const int32 Y)
+	{
+		if (X < 0 || Y < 0 || X >= Width || Y >= Height)
+		{
+			return false;
+		}
+		const FString& Row = Lines[LineIndex + Y];
+		return X < Row.Len() && IsMovingAIPassable(Row[X]);
+	};
+
+	TArray<FVector2D> Locations;
+	OutCellToNode.Init(INDEX_NONE, Width * Height);
+	for (int32 Y = 0; Y < Height; Y++)
+	{
+		for (int32 X = 0; X < Width; X++)
+		{
+			if (IsPassable(X, Y))
+			{
+				OutCellToNode[Y * Width + X] = Locations.Add(FVector2D(X * MovingAICellSize, Y * MovingAICellSize));
+			}
+		}
+	}
+
+	// Every Edge gets added once: right, down, and both lower Diagonals if they do not cut a Corner
+	FEdgeList EdgeList;
+	for (int32 Y = 0; Y < Height; Y++)
+	{
+		for (int32 X = 0; X < Width; X++)
+		{
+			const int32 NodeID = OutCellToNode[Y * Width + X];
+			if (NodeID == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const bool bRight = IsPassable(X + 1, Y);
+			const bool bLeft = IsPassable(X - 1, Y);
+			const bool bDown = IsPassable(X, Y + 1);
+			if (bRight)
+			{
+				EdgeList.Add(NodeID, OutCellToNode[Y * Width + X + 1], MovingAICellSize);
+			}
+			if (bDown)
+			{
+				EdgeList.Add(NodeID, OutCellToNode[(Y + 1) * Width + X], MovingAICellSize);
+			}
+			if (bDown && bRight && IsPassable(X + 1, Y + 1))
+			{
+				EdgeList.Add(NodeID, OutCellToNode[(Y + 1) * Width + X + 1], MovingAIDiagonalCost);
+			}
+			if (bDown && bLeft && IsPassable(X - 1, Y + 1))
+			{
+				EdgeList.Add(NodeID, OutCellToNode[(Y + 1) * Width + X - 1], MovingAIDiagonalCost);
+			}
+		}
+	}
+
+	OutGraph = UBytesPathfinder::BuildGraph(Locations, EdgeList.FromIDs, EdgeList.ToIDs, EdgeList.Weights);
+	OutGraph.GraphType = EBytesGraphType::Square;
+	return true;
+}
+
+FBytesMovingAIResult UBytesPathfinderDebug::RunMovingAIScenarios(const FString& MapFilePath, const FString& ScenarioFilePath)
+{
+	FBytesMovingAIResult Result;
+
+	FBytesGraph Graph;
+	TArray<int32> CellToNode;
+	int32 Width = 0;
+	int32 Height = 0;
+	if (!LoadMovingAIMap(MapFilePath, Graph, CellToNode, Width, Height))
+	{
+		return Result;
+	}
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *ScenarioFilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MovingAI: Could not read %s"), *ScenarioFilePath);
+		return Result;
+	}
+
+	// ==== Sub Section | Parse Scenarios ==== //
+	// Bucket, Map, Width, Height, Start X, Start Y, Goal X, Goal Y, Optimal Length
+
+	struct FScenario
+	{
+		int32 StartID;
+		int32 TargetID;
+		double OptimalLength;
+	};
+
+	TArray<FScenario> Scenarios;
+	for (const FString& Line : Lines)
+	{
+		TArray<FString> Tokens;
+		Line.ParseIntoArrayWS(Tokens);
+		if (Tokens.Num() != 9)
+		{
+			continue;
+		}
+
+		int32 MapWidth, MapHeight, StartX, StartY, GoalX, GoalY;
+		double OptimalLength;
+		LexFromString(MapWidth, *Tokens[2]);
+		LexFromString(MapHeight, *Tokens[3]);
+		LexFromString(StartX, *Tokens[4]);
+		LexFromString(StartY, *Tokens[5]);
+		LexFromString(GoalX, *Tokens[6]);
+		LexFromString(GoalY, *Tokens[7]);
+		LexFromString(OptimalLength, *Tokens[8]);
+
+		const bool bInside = StartX >= 0 && StartY >= 0 && GoalX >= 0 && GoalY >= 0 && StartX < Width && GoalX < Width && StartY < Height && GoalY < Height;
+		if (MapWidth != Width || MapHeight != Height || !bInside)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("MovingAI: Scenario does not fit the Map, skipped"));
+			continue;
+		}
+
+		const int32 StartID = CellToNode[StartY * Width + StartX];
+		const int32 TargetID = CellToNode[GoalY * Width + GoalX];
+		if (StartID == INDEX_NONE || TargetID == INDEX_NONE)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("MovingAI: Scenario starts or ends in a blocked Cell, skipped"));
+			continue;
+		}
+
+		Scenarios.Add({StartID, TargetID, OptimalLength});
+	}
+
+	// ==== Sub Section | Run ==== //
+
+	Result.NumScenarios = Scenarios.Num();
+
+	TArray<TArray<int32>> Paths;
+	Paths.SetNum(Scenarios.Num());
+
+	const double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < Scenarios.Num(); Index++)
+	{
+		Paths[Index] = UBytesPathfinder::GetPath(Graph, Scenarios[Index].StartID, Scenarios[Index].TargetID, true);
+	}
+	Result.TotalSeconds = FPlatformTime::Seconds() - StartTime;
+	Result.QueriesPerSecond = Result.TotalSeconds > 0.0 ? Scenarios.Num() / Result.TotalSeconds : 0.0;
+
+	// ==== Sub Section | Compare against optimal Lengths ==== //
+
+	double GapSum = 0.0;
+	for (int32 Index = 0; Index < Scenarios.Num(); Index++)
+	{
+		const FScenario& Scenario = Scenarios[Index];
+		const TArray<int32>& Path = Paths[Index];
+
+		if (Path.IsEmpty() && Scenario.StartID != Scenario.TargetID)
+		{
+			Result.NumFailed++;
+			continue;
+		}
+		Result.NumSolved++;
+
+		// Octile Length with exact Diagonals, the rounded Edge Weights are only used for Searching
+		double Length = 0.0;
+		int32 PreviousID = Scenario.StartID;
+		for (const int32 NodeID : Path)
+		{
+			const FVector2D Step = Graph.Nodes[NodeID].Location2D - Graph.Nodes[PreviousID].Location2D;
+			Length += (Step.X != 0.0 && Step.Y != 0.0) ? UE_DOUBLE_SQRT_2 : 1.0;
+			PreviousID = NodeID;
+		}
+
+		const double Gap = Scenario.OptimalLength > 0.0 ? (Length - Scenario.OptimalLength) / Scenario.OptimalLength : 0.0;
+		GapSum += Gap;
+		Result.MaxOptimalityGap = FMath::Max(Result.MaxOptimalityGap, Gap);
+	}
+	Result.MeanOptimalityGap = Result.NumSolved > 0 ? GapSum / Result.NumSolved : 0.0;
+
+	UE_LOG(LogTemp, Display, TEXT("MovingAI: %s | %d Scenarios, %d solved, %d failed | Mean Gap %.5f%%, Max Gap %.5f%% | %.1f Queries/s"),
+		*ScenarioFilePath, Result.NumScenarios, Result.NumSolved, Result.NumFailed,
+		Result.MeanOptimalityGap * 100.0, Result.MaxOptimalityGap * 100.0, Result.QueriesPerSecond);
+
+	return Result;
+}
+
+int32 UBytesPathfinderDebug::ValidateSolvers(const int32 NumGraphs, const int32 QueriesPerGraph, const int32 Seed)
+{
+	/*
+	 * Every Solver gets the Graph, Start, Target and a Cost Profile and returns a Path in the "GetPath()" Format.
+	 * An empty Path means unreachable, unless Start and Target are the same.
+	 * Solvers that ignore the Profile are checked against the unscaled Weights.
+	 */
+	struct FSolver
+	{
+		const TCHAR* Name;
+		bool bUsesProfile;
+		TFunction<TArray<int32>(FBytesGraph&, int32, int32, const FBytesCostProfile&)> Solve;
+	};
+
+	const FSolver Solvers[] =
+	{
+		{TEXT("GetPath (A*)"), false, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile&)
+		{
+			return UBytesPathfinder::GetPath(Graph, StartID, TargetID, true);
+		}},
+		{TEXT("GetPath (Path Cache)"), false, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile&)
+		{
+			// The second Query is answered by the Cache
+			UBytesPathfinder::SetPathCacheCapacity(Graph, 16);
+			UBytesPathfinder::GetPath(Graph, StartID, TargetID, true);
+			TArray<int32> Path = UBytesPathfinder::GetPath(Graph, StartID, TargetID, true);
+			UBytesPathfinder::SetPathCacheCapacity(Graph, 0);
+			return Path;
+		}},
+		{TEXT("GetPath (A*, Lazy Heap)"), false, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile&)
+		{
+			UBytesPathfinder::SetSearchQueue(Graph, EBytesSearchQueue::LazyHeap);
+			TArray<int32> Path = UBytesPathfinder::GetPath(Graph, StartID, TargetID, true);
+			UBytesPathfinder::SetSearchQueue(Graph, EBytesSearchQueue::IndexedHeap);
+			return Path;
+		}},
+		{TEXT("GetPathFromSource (Tree Cache)"), false, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile&)
+		{
+			return UBytesPathfinder::GetPathFromSource(Graph, StartID, TargetID);
+		}},
+		{TEXT("FindPathsToNodes (Dijkstra)"), false, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile&)
+		{
+			UBytesPathfinder::FindPathsToNodes(Graph, StartID);
+			return UBytesPathfinder::GetPath(Graph, StartID, TargetID, false);
+		}},
+		{TEXT("FindPathsToNodes (Dijkstra, Lazy Heap)"), false, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile&)
+		{
+			UBytesPathfinder::SetSearchQueue(Graph, EBytesSearchQueue::LazyHeap);
+			UBytesPathfinder::FindPathsToNodes(Graph, StartID);
+			UBytesPathfinder::SetSearchQueue(Graph, EBytesSearchQueue::IndexedHeap);
+			return UBytesPathfinder::GetPath(Graph, StartID, TargetID, false);
+		}},
+		{TEXT("FindPathsFromNodes (backwards Dijkstra)"), false, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile&)
+		{
+			UBytesPathfinder::FindPathsFromNodes(Graph, TargetID);
+			return UBytesPathfinder::GetPathToTarget(Graph, StartID, TargetID);
+		}},
+		{TEXT("GetPathWithProfile (A*)"), true, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile& Profile)
+		{
+			return UBytesPathfinder::GetPathWithProfile(Graph, StartID, TargetID, Profile);
+		}},
+		{TEXT("FindPathsToNodesWithProfile (Dijkstra)"), true, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile& Profile)
+		{
+			UBytesPathfinder::FindPathsToNodesWithProfile(Graph, StartID, Profile);
+			return UBytesPathfinder::GetPath(Graph, StartID, TargetID, false);
+		}},
+		{TEXT("GetPath (A*, sparse State)"), false, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile&)
+		{
+			UBytesPathfinder::SetSearchMemory(Graph, EBytesSearchMemory::Sparse);
+			TArray<int32> Path = UBytesPathfinder::GetPath(Graph, StartID, TargetID, true);
+			UBytesPathfinder::SetSearchMemory(Graph, EBytesSearchMemory::Dense);
+			return Path;
+		}},
+		{TEXT("GetPath (A*, automatic State)"), false, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile&)
+		{
+			UBytesPathfinder::SetSearchMemory(Graph, EBytesSearchMemory::Automatic);
+			TArray<int32> Path = UBytesPathfinder::GetPath(Graph, StartID, TargetID, true);
+			UBytesPathfinder::SetSearchMemory(Graph, EBytesSearchMemory::Dense);
+			return Path;
+		}},
+		{TEXT("GetPathWithProfile (A*, sparse State)"), true, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile& Profile)
+		{
+			UBytesPathfinder::SetSearchMemory(Graph, EBytesSearchMemory::Sparse);
+			TArray<int32> Path = UBytesPathfinder::GetPathWithProfile(Graph, StartID, TargetID, Profile);
+			UBytesPathfinder::SetSearchMemory(Graph, EBytesSearchMemory::Dense);
+			return Path;
+		}},
+		{TEXT("FringeSearch (Hash Table)"), false, [](FBytesGraph& Graph, const int32 StartID, const int32 TargetID, const FBytesCostProfile&)
+		{
+			TArray<int32> Path;
+			BytesSearch::FringeSearch(FBytesGraphAccessor(Graph), StartID, TargetID, Path);
+			return Path;
+		}},
+	};
+
+	int32 NumMismatches = 0;
+	for (int32 GraphIndex = 0; GraphIndex < NumGraphs; GraphIndex++)
+	{
+		// Every Graph has its own Seed, so a Mismatch can be reproduced alone
+		const int32 GraphSeed = Seed + GraphIndex;
+		FRandomStream Random(GraphSeed);
+		const bool bMetricWeights = GraphIndex % 2 == 1;
+		FBytesGraph Graph = CreateValidationGraph(Random, bMetricWeights);
+		const FBytesCostProfile Profile = CreateValidationProfile(Random);
+		const int32 NumNodes = Graph.Nodes.Num();
+
+		for (int32 Query = 0; Query < QueriesPerGraph; Query++)
+		{
+			const int32 StartID = Random.RandRange(0, NumNodes - 1);
+			const int32 TargetID = Random.RandRange(0, NumNodes - 1);
+			if (!Graph.IsValidNode(StartID) || !Graph.IsValidNode(TargetID))
+			{
+				continue;
+			}
+
+			const int64 ExpectedCost = ReferenceDijkstra(Graph, StartID, nullptr)[TargetID];
+			const int64 ExpectedProfileCost = ReferenceDijkstra(Graph, StartID, &Profile)[TargetID];
+
+			for (const FSolver& Solver : Solvers)
+			{
+				const FBytesCostProfile* SolverProfile = Solver.bUsesProfile ? &Profile : nullptr;
+				const int64 ExpectedSolverCost = Solver.bUsesProfile ? ExpectedProfileCost : ExpectedCost;
+
+				const TArray<int32> Path = Solver.Solve(Graph, StartID, TargetID, Profile);
+				const bool bReached = !Path.IsEmpty() || StartID == TargetID;
+				const int64 Cost = bReached ? MeasurePath(Graph, StartID, Path, SolverProfile) : INDEX_NONE;
+				const bool bEndsAtTarget = Path.IsEmpty() || Path.Last() == TargetID;
+
+				if (Cost != ExpectedSolverCost || !bEndsAtTarget)
+				{
+					NumMismatches++;
+					UE_LOG(LogTemp, Error, TEXT("Validate Solvers: %s | Graph Seed %d | %d -> %d | Cost %lld, expected %lld"),
+						Solver.Name, GraphSeed, StartID, TargetID, Cost, ExpectedSolverCost);
+				}
+			}
+
+			// Both Simplifications of the cheapest Path
+			{
+				const TArray<int32> Path = UBytesPathfinder::GetPath(Graph, StartID, TargetID, true);
+				for (const EBytesPathSimplification Simplification : {EBytesPathSimplification::RemoveCollinear, EBytesPathSimplification::PullString})
+				{
+					const TArray<int32> Simplified = UBytesPathfinder::SimplifyPath(Graph, StartID, Path, Simplification);
+					if (!IsSimplifiedPathValid(FBytesGraphAccessor(Graph), FBytesGraphLineOfSight(), StartID, Path, Simplified, Simplification))
+					{
+						NumMismatches++;
+						UE_LOG(LogTemp, Error, TEXT("Validate Solvers: SimplifyPath (%s) | Graph Seed %d | %d -> %d | %d of %d Nodes left, invalid"),
+							Simplification == EBytesPathSimplification::PullString ? TEXT("String Pulling") : TEXT("Collinear"), GraphSeed, StartID, TargetID, Simplified.Num(), Path.Num());
+					}
+				}
+			}
+
+			// Weighted A* stays within its Weight of the cheapest Path
+			for (const double Weight : {1.5, 3.0})
+			{
+				UBytesPathfinder::SetHeuristicWeight(Graph, Weight);
+				const TArray<int32> Path = UBytesPathfinder::GetPath(Graph, StartID, TargetID, true);
+				UBytesPathfinder::SetHeuristicWeight(Graph, 1.0);
+
+				const bool bReached = !Path.IsEmpty() || StartID == TargetID;
+				const int64 Cost = bReached ? MeasurePath(Graph, StartID, Path, nullptr) : INDEX_NONE;
+				if (bReached != (ExpectedCost != INDEX_NONE) || (bReached && (Cost == INDEX_NONE || Cost > Weight * ExpectedCost)))
+				{
+					NumMismatches++;
+					UE_LOG(LogTemp, Error, TEXT("Validate Solvers: Weighted A* %.1f | Graph Seed %d | %d -> %d | Cost %lld, cheapest %lld"), Weight, GraphSeed, StartID, TargetID, Cost, ExpectedCost);
+				}
+			}
+
+			// Anytime A* stays within the Bound it reports after every Iteration and ends with the cheapest Path
+			{
+				const FBytesGraphAccessor Accessor(Graph);
+				FBytesSearchState State;
+				TBytesAnytimeAStar<FBytesGraphAccessor> Search(Accessor, State, StartID, TargetID, 3.0, 0.5);
+				int64 Cost = INDEX_NONE;
+				bool bWithinBound = true;
+				do
+				{
+					Search.Improve();
+					const TArray<int32> Path = BytesSearch::RetracePath(State, StartID, TargetID);
+					Cost = Search.HasPath() ? MeasurePath(Graph, StartID, Path, nullptr) : INDEX_NONE;
+					bWithinBound &= Cost == INDEX_NONE || (Cost <= Search.GetSuboptimalityBound() * ExpectedCost && Search.GetSuboptimalityBound() <= 3.0);
+				}
+				while (!Search.IsOptimal() && Search.GetNumIterations() < 10);
+
+				if (!bWithinBound || !Search.IsOptimal() || Cost != ExpectedCost)
+				{
+					NumMismatches++;
+					UE_LOG(LogTemp, Error, TEXT("Validate Solvers: Anytime A* | Graph Seed %d | %d -> %d | Cost %lld after %d Iterations, cheapest %lld%s"),
+						GraphSeed, StartID, TargetID, Cost, Search.GetNumIterations(), ExpectedCost, bWithinBound ? TEXT("") : TEXT(", Bound broken"));
+				}
+			}
+
+			// Any Angle Paths are not the cheapest along the Edges, they have to reach every reachable Target over valid Lines
+			for (const EBytesPathMode PathMode : {EBytesPathMode::AnyAngle, EBytesPathMode::LazyAnyAngle})
+			{
+				UBytesPathfinder::SetPathMode(Graph, PathMode);
+				const TArray<int32> Path = UBytesPathfinder::GetPath(Graph, StartID, TargetID, true);
+				UBytesPathfinder::SetPathMode(Graph, EBytesPathMode::GraphEdges);
+
+				const bool bReached = !Path.IsEmpty() || StartID == TargetID;
+				const bool bValid = !bReached || IsAnyAngleTreeValid(FBytesGraphAccessor(Graph), FBytesGraphLineOfSight(), Graph.SearchState, StartID, TargetID);
+				if (bReached != (ExpectedCost != INDEX_NONE) || !bValid)
+				{
+					NumMismatches++;
+					UE_LOG(LogTemp, Error, TEXT("Validate Solvers: GetPath (%s) | Graph Seed %d | %d -> %d | %s"), PathMode == EBytesPathMode::AnyAngle ? TEXT("Theta*") : TEXT("Lazy Theta*"),
+						GraphSeed, StartID, TargetID, bValid ? TEXT("Reachability differs") : TEXT("Path uses an invalid Line"));
+				}
+			}
+		}
+
+		// Compaction has to recalculate the Heuristic Scale from the Edges left, not keep the lowest one ever seen
+		UBytesPathfinder::CompactGraph(Graph);
+		double ExpectedScale = 1.0;
+		for (int32 NodeID = 0; NodeID < Graph.Nodes.Num(); NodeID++)
+		{
+			for (const FBytesEdge& Edge : Graph.Edges[NodeID].NeighbouringEdges)
+			{
+				const double Length = FVector2D::Distance(Graph.Nodes[NodeID].Location2D, Graph.Nodes[Edge.NodeID].Location2D);
+				ExpectedScale = Length > 0.0 ? FMath::Min(ExpectedScale, FMath::Max(Edge.Weight, 0) / Length) : ExpectedScale;
+			}
+		}
+		if (Graph.HeuristicScale != ExpectedScale || (bMetricWeights && Graph.HeuristicScale < 1.0))
+		{
+			NumMismatches++;
+			UE_LOG(LogTemp, Error, TEXT("Validate Solvers: CompactGraph | Graph Seed %d | Heuristic Scale %f, expected %f"), GraphSeed, Graph.HeuristicScale, ExpectedScale);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Validate Solvers: %d Graphs, %d Mismatches"), NumGraphs, NumMismatches);
+	return NumMismatches;
+}
+
+int32 UBytesPathfinderDebug::ValidateGridSolvers(const int32 NumGrids, const int32 QueriesPerGrid, const int32 Seed)
+{
+	// Same Format as the Solvers of "ValidateSolvers()", the Grid brings its explicit Copy for Reference
+	struct FGridSolver
+	{
+		const TCHAR* Name;
+		TFunction<TArray<int32>(FBytesGridGraph&, FBytesSearchState&, int32, int32)> Solve;
+	};
+
+	const FGridSolver Solvers[] =
+	{
+		{TEXT("AStar (Euclidean Heuristic)"), [](FBytesGridGraph& Grid, FBytesSearchState& State, const int32 StartID, const int32 TargetID)
+		{
+			BytesSearch::AStar(Grid, State, StartID, TargetID);
+			return BytesSearch::RetracePath(State, StartID, TargetID);
+		}},
+		{TEXT("AStar (Grid Heuristic)"), [](FBytesGridGraph& Grid, FBytesSearchState& State, const int32 StartID, const int32 TargetID)
+		{
+			BytesSearch::AStar<FBytesIndexedQueue, FBytesGridHeuristic>(Grid, State, StartID, TargetID);
+			return BytesSearch::RetracePath(State, StartID, TargetID);
+		}},
+		{TEXT("GridAStar (Scalar Kernel)"), [](FBytesGridGraph& Grid, FBytesSearchState& State, const int32 StartID, const int32 TargetID)
+		{
+			Grid.SetSimdEnabled(false);
+			BytesSearch::GridAStar(Grid, State, StartID, TargetID);
+			Grid.SetSimdEnabled(true);
+			return BytesSearch::RetracePath(State, StartID, TargetID);
+		}},
+		{TEXT("GridAStar (SIMD Kernel, Lazy Heap)"), [](FBytesGridGraph& Grid, FBytesSearchState& State, const int32 StartID, const int32 TargetID)
+		{
+			BytesSearch::GridAStar<FBytesLazyQueue>(Grid, State, StartID, TargetID);
+			return BytesSearch::RetracePath(State, StartID, TargetID);
+		}},
+		{TEXT("Dijkstra (backwards)"), [](FBytesGridGraph& Grid, FBytesSearchState& State, const int32 StartID, const int32 TargetID)
+		{
+			BytesSearch::Dijkstra(TBytesReversedGraph<FBytesGridGraph>(Grid), State, TargetID);
+			return BytesSearch::FollowPath(State, StartID, TargetID);
+		}},
+		{TEXT("AStar (sparse State)"), [](FBytesGridGraph& Grid, FBytesSearchState&, const int32 StartID, const int32 TargetID)
+		{
+			FBytesSparseSearchState SparseState;
+			BytesSearch::AStar<FBytesSparseLazyQueue, FBytesGridHeuristic>(Grid, SparseState, StartID, TargetID);
+			return BytesSearch::RetracePath(SparseState, StartID, TargetID);
+		}},
+		{TEXT("FringeSearch (Grid Heuristic)"), [](FBytesGridGraph& Grid, FBytesSearchState&, const int32 StartID, const int32 TargetID)
+		{
+			TArray<int32> Path;
+			BytesSearch::FringeSearch<FBytesGridHeuristic>(Grid, StartID, TargetID, Path);
+			return Path;
+		}},
+	};
+
+	static const EBytesGridConnectivity Connectivities[] = {EBytesGridConnectivity::Four, EBytesGridConnectivity::Eight, EBytesGridConnectivity::Hex};
+
+	int32 NumMismatches = 0;
+	for (int32 GridIndex = 0; GridIndex < NumGrids; GridIndex++)
+	{
+		const int32 GridSeed = Seed + GridIndex;
+		FRandomStream Random(GridSeed);
+
+		// Narrow Grids hit the Bounds in every Direction, wide ones the Word Borders of the Walkable Bits.
+		// Open Grids take the straight Fast Path of "GridAStar()"
+		const EBytesGridConnectivity Connectivity = Connectivities[Random.RandRange(0, 2)];
+		FBytesGridGraph Grid(Random.RandRange(1, 24) * Random.RandRange(1, 4), Random.RandRange(1, 24) * Random.RandRange(1, 4), Connectivity);
+		const float BlockedChance = Random.RandRange(0, 3) == 0 ? 0.0f : Random.FRandRange(0.0f, 0.4f);
+		// Uniform, mixed and Grids without any Cell of Cost 1, whose Heuristic has to scale with the cheapest Cell
+		const FIntPoint CostRanges[] = {{1, 1}, {1, 5}, {5, 5}, {3, 9}};
+		const FIntPoint CostRange = CostRanges[Random.RandRange(0, 3)];
+		ScatterGridCells(Grid, Random, BlockedChance, CostRange.X, CostRange.Y);
+
+		// Blocking and unblocking again, so the cheapest Cost also has to rise once its last Cell is gone
+		const int32 ReblockedID = Random.RandRange(0, Grid.NumNodes() - 1);
+		const uint8 ReblockedCost = Grid.GetCellCost(ReblockedID);
+		Grid.SetCellCost(ReblockedID, 0);
+		Grid.SetCellCost(ReblockedID, ReblockedCost);
+
+		uint8 CheapestCost = 0;
+		for (int32 NodeID = 0; NodeID < Grid.NumNodes(); NodeID++)
+		{
+			const uint8 Cost = Grid.GetCellCost(NodeID);
+			CheapestCost = Cost != 0 && (CheapestCost == 0 || Cost < CheapestCost) ? Cost : CheapestCost;
+		}
+		if (CheapestCost != 0 && Grid.GetHeuristicScale() != CheapestCost)
+		{
+			NumMismatches++;
+			UE_LOG(LogTemp, Error, TEXT("Validate Grid Solvers: Heuristic Scale | Grid Seed %d | %f, cheapest Cell costs %d"), GridSeed, Grid.GetHeuristicScale(), CheapestCost);
+		}
+
+		FBytesGraph Graph;
+		Grid.CopyToGraph(Graph);
+
+		// ==== Sub Section | Kernels ==== //
+		// Every Cell towards a random Target, both Kernels have to agree Lane by Lane
+		const int32 KernelTargetID = Random.RandRange(0, Grid.NumNodes() - 1);
+		for (int32 NodeID = 0; NodeID < Grid.NumNodes(); NodeID++)
+		{
+			FBytesGridExpansion Scalar;
+			FBytesGridExpansion Simd;
+			const int32 GCost = Random.RandRange(0, 1) ? Random.RandRange(0, 1000) : INITIAL_DISTANCE - Random.RandRange(1, 200);
+
+			Grid.SetSimdEnabled(false);
+			Grid.ExpandNeighbours(NodeID, GCost, KernelTargetID, Scalar);
+			Grid.SetSimdEnabled(true);
+			Grid.ExpandNeighbours(NodeID, GCost, KernelTargetID, Simd);
+
+			bool bEqual = Scalar.Num == Simd.Num;
+			for (int32 Index = 0; bEqual && Index < Scalar.Num; Index++)
+			{
+				bEqual = Scalar.NeighbourIDs[Index] == Simd.NeighbourIDs[Index] && Scalar.GCosts[Index] == Simd.GCosts[Index] && Scalar.HCosts[Index] == Simd.HCosts[Index];
+			}
+			if (!bEqual)
+			{
+				NumMismatches++;
+				UE_LOG(LogTemp, Error, TEXT("Validate Grid Solvers: %s Kernel | Grid Seed %d | Cell %d differs from the scalar Kernel"), Grid.GetKernelName(), GridSeed, NodeID);
+			}
+		}
+
+		// ==== Sub Section | Walkability ==== //
+		// Word Scans and Bit Spans against Cell by Cell Loops
+		int32 NumWalkabilityErrors = 0;
+		for (int32 Check = 0; Check < QueriesPerGrid; Check++)
+		{
+			const FIntPoint Cell = Grid.GetCell(Random.RandRange(0, Grid.NumNodes() - 1));
+			for (const int32 Step : {1, -1})
+			{
+				int32 Row = 0;
+				while (Grid.IsWalkable(Cell.X + (Row + 1) * Step, Cell.Y))
+				{
+					Row++;
+				}
+				int32 Column = 0;
+				while (Grid.IsWalkable(Cell.X, Cell.Y + (Column + 1) * Step))
+				{
+					Column++;
+				}
+				NumWalkabilityErrors += Grid.ScanRow(Cell.X, Cell.Y, Step) != Row;
+				NumWalkabilityErrors += Grid.ScanColumn(Cell.X, Cell.Y, Step) != Column;
+			}
+
+			const FIntPoint Corner = Grid.GetCell(Random.RandRange(0, Grid.NumNodes() - 1));
+			bool bRectWalkable = true;
+			for (int32 Y = FMath::Min(Cell.Y, Corner.Y); Y <= FMath::Max(Cell.Y, Corner.Y); Y++)
+			{
+				for (int32 X = FMath::Min(Cell.X, Corner.X); X <= FMath::Max(Cell.X, Corner.X); X++)
+				{
+					bRectWalkable &= Grid.IsWalkable(X, Y);
+				}
+			}
+			NumWalkabilityErrors += Grid.IsRectWalkable(FMath::Min(Cell.X, Corner.X), FMath::Min(Cell.Y, Corner.Y), FMath::Max(Cell.X, Corner.X), FMath::Max(Cell.Y, Corner.Y)) != bRectWalkable;
+
+			// Hex Lines have no simple Reference, they have to be symmetric at least
+			const bool bLineOfSight = Grid.HasLineOfSight(Grid.GetNodeID(Cell.X, Cell.Y), Grid.GetNodeID(Corner.X, Corner.Y));
+			const bool bExpected = Connectivity == EBytesGridConnectivity::Hex
+				? Grid.HasLineOfSight(Grid.GetNodeID(Corner.X, Corner.Y), Grid.GetNodeID(Cell.X, Cell.Y))
+				: ReferenceLineOfSight(Grid, Cell, Corner);
+			NumWalkabilityErrors += bLineOfSight != bExpected;
+		}
+		if (NumWalkabilityErrors > 0)
+		{
+			NumMismatches += NumWalkabilityErrors;
+			UE_LOG(LogTemp, Error, TEXT("Validate Grid Solvers: Walkability | Grid Seed %d | %d Scans, Rects or Lines of Sight differ from the Reference"), GridSeed, NumWalkabilityErrors);
+		}
+
+		// ==== Sub Section | Solvers ==== //
+
+		for (int32 Query = 0; Query < QueriesPerGrid; Query++)
+		{
+			const int32 StartID = GetRandomPassableCell(Grid, Random);
+			const int32 TargetID = GetRandomPassableCell(Grid, Random);
+			if (StartID == INDEX_NONE || TargetID == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const int64 ExpectedCost = ReferenceDijkstra(Graph, StartID, nullptr)[TargetID];
+			for (const FGridSolver& Solver : Solvers)
+			{
+				FBytesSearchState State;
+				const TArray<int32> Path = Solver.Solve(Grid, State, StartID, TargetID);
+				const bool bReached = !Path.IsEmpty() || StartID == TargetID;
+				const int64 Cost = bReached ? MeasurePath(Graph, StartID, Path, nullptr) : INDEX_NONE;
+				const bool bEndsAtTarget = Path.IsEmpty() || Path.Last() == TargetID;
+
+				if (Cost != ExpectedCost || !bEndsAtTarget)
+				{
+					NumMismatches++;
+					UE_LOG(LogTemp, Error, TEXT("Validate Grid Solvers: %s | Grid Seed %d | %d -> %d | Cost %lld, expected %lld"),
+						Solver.Name, GridSeed, StartID, TargetID, Cost, ExpectedCost);
+				}
+			}
+
+			// Simplifications of the Grid Path, String Pulling with the Lines of the Bits
+			{
+				FBytesSearchState State;
+				BytesSearch::GridAStar(Grid, State, StartID, TargetID);
+				const TArray<int32> Path = BytesSearch::RetracePath(State, StartID, TargetID);
+
+				TArray<int32> Collinear = Path;
+				BytesSearch::RemoveCollinearNodes(Grid, StartID, Collinear);
+				TArray<int32> Pulled = Path;
+				BytesSearch::PullString(Grid, FBytesGridLineOfSight(), StartID, Pulled);
+
+				if (!IsSimplifiedPathValid(Grid, FBytesGridLineOfSight(), StartID, Path, Collinear, EBytesPathSimplification::RemoveCollinear)
+					|| !IsSimplifiedPathValid(Grid, FBytesGridLineOfSight(), StartID, Path, Pulled, EBytesPathSimplification::PullString))
+				{
+					NumMismatches++;
+					UE_LOG(LogTemp, Error, TEXT("Validate Grid Solvers: Path Simplification | Grid Seed %d | %d -> %d | %d Nodes, %d Collinear, %d Pulled"),
+						GridSeed, StartID, TargetID, Path.Num(), Collinear.Num(), Pulled.Num());
+				}
+			}
+
+			// Any Angle: every reachable Target over Lines the Bits allow, Lines from walking Neighbours on the Grid too
+			for (int32 Variant = 0; Variant < 3; Variant++)
+			{
+				FBytesSearchState State;
+				bool bReached;
+				bool bValid;
+				if (Variant == 2)
+				{
+					bReached = BytesSearch::ThetaStar<FBytesGraphLineOfSight, FBytesLazyQueue>(Grid, State, StartID, TargetID);
+					bValid = !bReached || IsAnyAngleTreeValid(Grid, FBytesGraphLineOfSight(), State, StartID, TargetID);
+				}
+				else
+				{
+					bReached = Variant == 0
+						? BytesSearch::ThetaStar<FBytesGridLineOfSight>(Grid, State, StartID, TargetID)
+						: BytesSearch::LazyThetaStar<FBytesGridLineOfSight>(Grid, State, StartID, TargetID);
+					bValid = !bReached || IsAnyAngleTreeValid(Grid, FBytesGridLineOfSight(), State, StartID, TargetID);
+				}
+
+				if (bReached != (ExpectedCost != INDEX_NONE) || !bValid)
+				{
+					static const TCHAR* VariantNames[] = {TEXT("Theta* (Grid Lines)"), TEXT("Lazy Theta* (Grid Lines)"), TEXT("Theta* (walked Lines, Lazy Heap)")};
+					NumMismatches++;
+					UE_LOG(LogTemp, Error, TEXT("Validate Grid Solvers: %s | Grid Seed %d | %d -> %d | %s"), VariantNames[Variant], GridSeed, StartID, TargetID,
+						bValid ? TEXT("Reachability differs") : TEXT("Path uses an invalid Line"));
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Validate Grid Solvers: %d Grids, %d Mismatches"), NumGrids, NumMismatches);
+	return NumMismatches;
+}
+
+TArray<FBytesBenchmarkResult> UBytesPathfinderDebug::RunGridBenchmarks(const int32 Side, const float BlockedChance, const int32 NumQueries, const int32 Seed)
+{
+	static const EBytesGridConnectivity Connectivities[] = {EBytesGridConnectivity::Four, EBytesGridConnectivity::Eight, EBytesGridConnectivity::Hex};
+
+	TArray<FBytesBenchmarkResult> Results;
+	for (const EBytesGridConnectivity Connectivity : Connectivities)
+	{
+		FRandomStream Random(Seed);
+		FBytesGridGraph Grid(Side, Side, Connectivity);
+		ScatterGridCells(Grid, Random, BlockedChance, 1, 1);
+		const FString GridName = FString::Printf(TEXT("%s %d"), GetConnectivityName(Connectivity), Grid.NumNodes());
+
+		FBytesGraph Graph;
+		Grid.CopyToGraph(Graph);
+
+		// Same Queries for every Entry Point
+		TArray<int32> StartIDs;
+		TArray<int32> TargetIDs;
+		for (int32 Query = 0; Query < NumQueries; Query++)
+		{
+			const int32 StartID = GetRandomPassableCell(Grid, Random);
+			const int32 TargetID = GetRandomPassableCell(Grid, Random);
+			if (StartID != INDEX_NONE && TargetID != INDEX_NONE)
+			{
+				StartIDs.Add(StartID);
+				TargetIDs.Add(TargetID);
+			}
+		}
+		const int32 NumGridQueries = StartIDs.Num();
+		if (NumGridQueries == 0)
+		{
+			continue;
+		}
+
+		// ==== Sub Section | FindPath on the explicit Graph ==== //
+		{
+			FBytesSearchStats Stats;
+			const FBytesGraphAccessor Accessor(Graph);
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Query = 0; Query < NumGridQueries; Query++)
+			{
+				BytesSearch::AStar(Accessor, Graph.SearchState, StartIDs[Query], TargetIDs[Query], &Stats);
+			}
+			FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeResult(Graph, GridName, TEXT("FindPath (explicit Graph)"), NumGridQueries, FPlatformTime::Seconds() - StartTime));
+			Result.Stats = Stats;
+		}
+
+		// ==== Sub Section | Scalar Loop and Kernels ==== //
+		// The generic Loop visits Neighbours one by one, the Kernels compute all of them at once. All three expand the same Nodes
+		FBytesSearchState State;
+		{
+			FBytesSearchStats Stats;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Query = 0; Query < NumGridQueries; Query++)
+			{
+				BytesSearch::AStar<FBytesIndexedQueue, FBytesGridHeuristic>(Grid, State, StartIDs[Query], TargetIDs[Query], &Stats);
+			}
+			FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeGridResult(Grid, GridName, TEXT("AStar (Grid, generic Loop)"), NumGridQueries, FPlatformTime::Seconds() - StartTime));
+			Result.Stats = Stats;
+		}
+
+		for (const bool bSimd : {false, true})
+		{
+			Grid.SetSimdEnabled(bSimd);
+			FBytesSearchStats Stats;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Query = 0; Query < NumGridQueries; Query++)
+			{
+				BytesSearch::GridAStar(Grid, State, StartIDs[Query], TargetIDs[Query], &Stats);
+			}
+			const FString EntryPoint = FString::Printf(TEXT("GridAStar (%s Kernel)"), Grid.GetKernelName());
+			FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeGridResult(Grid, GridName, *EntryPoint, NumGridQueries, FPlatformTime::Seconds() - StartTime));
+			Result.Stats = Stats;
+		}
+
+		// ==== Sub Section | Weighted and Anytime ==== //
+		// Fewer Expansions for bounded Detours. Anytime A* once for its first Path and once until it is the cheapest
+		for (int32 Variant = 0; Variant < 4; Variant++)
+		{
+			TUniquePtr<TBytesAnytimeAStar<FBytesGridGraph, FBytesGridHeuristic>> Anytime;
+			const auto Search = [&Grid, &State, &Anytime, Variant](const int32 StartID, const int32 TargetID, FBytesSearchStats* Stats)
+			{
+				if (Variant < 2)
+				{
+					BytesSearch::WeightedAStar<FBytesIndexedQueue, FBytesGridHeuristic>(Grid, State, StartID, TargetID, Variant == 0 ? 1.5 : 3.0, Stats);
+					return;
+				}
+
+				Anytime = MakeUnique<TBytesAnytimeAStar<FBytesGridGraph, FBytesGridHeuristic>>(Grid, State, StartID, TargetID, 3.0, 0.5);
+				do
+				{
+					Anytime->Improve(Stats);
+				}
+				while (Variant == 3 && !Anytime->IsOptimal());
+			};
+
+			FBytesSearchStats Stats;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Query = 0; Query < NumGridQueries; Query++)
+			{
+				Search(StartIDs[Query], TargetIDs[Query], &Stats);
+			}
+
+			static const TCHAR* EntryPoints[] = {TEXT("WeightedAStar (1.5)"), TEXT("WeightedAStar (3)"), TEXT("AnytimeAStar (first Path)"), TEXT("AnytimeAStar (cheapest Path)")};
+			FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeGridResult(Grid, GridName, EntryPoints[Variant], NumGridQueries, FPlatformTime::Seconds() - StartTime));
+			Result.Stats = Stats;
+
+			for (int32 Query = 0; Query < NumGridQueries; Query++)
+			{
+				Search(StartIDs[Query], TargetIDs[Query], nullptr);
+				if (State.GCost[TargetIDs[Query]] != INITIAL_DISTANCE)
+				{
+					Result.PathCost += State.GCost[TargetIDs[Query]];
+					Result.PathNodes += BytesSearch::RetracePath(State, StartIDs[Query], TargetIDs[Query]).Num();
+				}
+			}
+		}
+
+		// ==== Sub Section | Local Queries ==== //
+		// Targets at most 8 Cells away, the dense State sets up every Cell for a few hundred reached ones
+		{
+			TArray<int32> LocalTargetIDs;
+			for (int32 Query = 0; Query < NumGridQueries; Query++)
+			{
+				const FIntPoint Cell = Grid.GetCell(StartIDs[Query]);
+				int32 TargetID = StartIDs[Query];
+				for (int32 Try = 0; Try < 8; Try++)
+				{
+					const int32 X = FMath::Clamp(Cell.X + Random.RandRange(-8, 8), 0, Grid.GetWidth() - 1);
+					const int32 Y = FMath::Clamp(Cell.Y + Random.RandRange(-8, 8), 0, Grid.GetHeight() - 1);
+					if (Grid.IsWalkable(X, Y))
+					{
+						TargetID = Grid.GetNodeID(X, Y);
+						break;
+					}
+				}
+				LocalTargetIDs.Add(TargetID);
+			}
+
+			FBytesSparseSearchState SparseState;
+			for (const bool bSparse : {false, true})
+			{
+				FBytesSearchStats Stats;
+				int64 PathCost = 0;
+				const double StartTime = FPlatformTime::Seconds();
+				for (int32 Query = 0; Query < NumGridQueries; Query++)
+				{
+					if (bSparse)
+					{
+						if (BytesSearch::AStar<FBytesSparseLazyQueue, FBytesGridHeuristic>(Grid, SparseState, StartIDs[Query], LocalTargetIDs[Query], &Stats))
+						{
+							PathCost += SparseState.GCost[LocalTargetIDs[Query]];
+						}
+					}
+					else
+					{
+						if (BytesSearch::AStar<FBytesLazyQueue, FBytesGridHeuristic>(Grid, State, StartIDs[Query], LocalTargetIDs[Query], &Stats))
+						{
+							PathCost += State.GCost[LocalTargetIDs[Query]];
+						}
+					}
+				}
+
+				FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeGridResult(Grid, GridName, bSparse ? TEXT("AStar (local Queries, sparse State)") : TEXT("AStar (local Queries, dense State)"),
+					NumGridQueries, FPlatformTime::Seconds() - StartTime));
+				Result.Stats = Stats;
+				Result.PathCost = PathCost;
+				if (bSparse)
+				{
+					Result.SearchBytes = SparseState.GetAllocatedSize();
+				}
+			}
+		}
+
+		// ==== Sub Section | Memory Bounded ==== //
+		// No Search State for the whole Grid, the Hash Table only holds the reached Cells
+		{
+			TArray<int32> Path;
+			FBytesSearchStats Stats;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Query = 0; Query < NumGridQueries; Query++)
+			{
+				BytesSearch::FringeSearch<FBytesGridHeuristic>(Grid, StartIDs[Query], TargetIDs[Query], Path, &Stats);
+			}
+
+			FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeGridResult(Grid, GridName, TEXT("FringeSearch (Hash Table)"), NumGridQueries, FPlatformTime::Seconds() - StartTime));
+			Result.Stats = Stats;
+
+			for (int32 Query = 0; Query < NumGridQueries; Query++)
+			{
+				if (BytesSearch::FringeSearch<FBytesGridHeuristic>(Grid, StartIDs[Query], TargetIDs[Query], Path))
+				{
+					Result.PathCost += BytesSearch::GetPathCost(Grid, FBytesGridLineOfSight(), StartIDs[Query], Path);
+					Result.PathNodes += Path.Num();
+				}
+			}
+		}
+
+		// ==== Sub Section | Any Angle ==== //
+		// Path Shapes are compared outside the timed Loop: Cost and Nodes of the Grid Path against the straight Lines
+		// Simplified Paths are measured Step by Step, their Nodes are no longer connected by Edges
+		for (int32 Variant = 0; Variant < 5; Variant++)
+		{
+			TArray<int32> Path;
+			const auto Search = [&Grid, &State, &Path, Variant](const int32 StartID, const int32 TargetID, FBytesSearchStats* Stats)
+			{
+				if (Variant == 1)
+				{
+					BytesSearch::ThetaStar<FBytesGridLineOfSight>(Grid, State, StartID, TargetID, Stats);
+				}
+				else if (Variant == 2)
+				{
+					BytesSearch::LazyThetaStar<FBytesGridLineOfSight>(Grid, State, StartID, TargetID, Stats);
+				}
+				else
+				{
+					BytesSearch::GridAStar(Grid, State, StartID, TargetID, Stats);
+				}
+
+				Path = BytesSearch::RetracePath(State, StartID, TargetID);
+				if (Variant == 3)
+				{
+					BytesSearch::RemoveCollinearNodes(Grid, StartID, Path);
+				}
+				else if (Variant == 4)
+				{
+					BytesSearch::PullString(Grid, FBytesGridLineOfSight(), StartID, Path);
+				}
+			};
+
+			FBytesSearchStats Stats;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Query = 0; Query < NumGridQueries; Query++)
+			{
+				Search(StartIDs[Query], TargetIDs[Query], &Stats);
+			}
+
+			static const TCHAR* EntryPoints[] = {TEXT("GridAStar (Path Shape)"), TEXT("ThetaStar (Grid Lines)"), TEXT("LazyThetaStar (Grid Lines)"),
+				TEXT("GridAStar + RemoveCollinear"), TEXT("GridAStar + PullString")};
+			FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeGridResult(Grid, GridName, EntryPoints[Variant], NumGridQueries, FPlatformTime::Seconds() - StartTime));
+			Result.Stats = Stats;
+
+			for (int32 Query = 0; Query < NumGridQueries; Query++)
+			{
+				Search(StartIDs[Query], TargetIDs[Query], nullptr);
+				if (State.GCost[TargetIDs[Query]] != INITIAL_DISTANCE)
+				{
+					Result.PathCost += Variant < 3 ? State.GCost[TargetIDs[Query]] : BytesSearch::GetPathCost(Grid, FBytesGridLineOfSight(), StartIDs[Query], Path);
+					Result.PathNodes += Path.Num();
+				}
+			}
+		}
+	}
+
+	LogBenchmarkResults(Results);
+	return Results;
+}
+
+int32 UBytesPathfinderDebug::ValidateCooperativePaths(const int32 NumGraphs, const int32 AgentsPerGraph, const int32 Seed)
+{
+	int32 NumMismatches = 0;
+
+	// Every Graph gets assigned into the same Variable, Costs cached for the one before must not leak into it
+	FBytesGraph ReusedGraph;
+	for (int32 GraphIndex = 0; GraphIndex < NumGraphs; GraphIndex++)
+	{
+		const int32 GraphSeed = Seed + GraphIndex;
+		FRandomStream Random(GraphSeed);
+
+		// Random Graphs cover every Edge Kind, small Grids crowded with Agents cover Waiting and Swaps
+		FBytesGraph Graph = Random.RandRange(0, 1) ? CreateValidationGraph(Random) : CreateSquareGridGraph(Random.RandRange(1, 8), Random.RandRange(1, 8), Random.RandRange(0, 1) == 1);
+		const int32 NumNodes = Graph.Nodes.Num();
+
+		FBytesCooperativePlanner Planner;
+		Planner.WindowSize = Random.RandRange(1, 12);
+		Planner.WaitCost = Random.RandRange(0, 150);
+
+		// Every Agent on its own Start
+		TArray<int32> FreeNodeIDs;
+		for (int32 NodeID = 0; NodeID < NumNodes; NodeID++)
+		{
+			if (Graph.IsValidNode(NodeID))
+			{
+				FreeNodeIDs.Add(NodeID);
+			}
+		}
+		TArray<FBytesAgentRequest> Agents;
+		while (Agents.Num() < AgentsPerGraph && !FreeNodeIDs.IsEmpty())
+		{
+			FBytesAgentRequest& Agent = Agents.AddDefaulted_GetRef();
+			const int32 Index = Random.RandRange(0, FreeNodeIDs.Num() - 1);
+			Agent.StartID = FreeNodeIDs[Index];
+			FreeNodeIDs.RemoveAtSwap(Index);
+			do
+			{
+				Agent.TargetID = Random.RandRange(0, NumNodes - 1);
+			}
+			while (!Graph.IsValidNode(Agent.TargetID));
+		}
+
+		if (Agents.IsEmpty())
+		{
+			continue;
+		}
+
+		// ==== Sub Section | Single Agent ==== //
+		// Nothing to plan around, so the Estimate is the cheapest Path
+		{
+			TArray<FBytesAgentPlan> Plans;
+			ReusedGraph = Graph;
+			UBytesMultiAgent::PlanCooperativePaths(ReusedGraph, Planner, {Agents[0]}, Plans);
+			const int64 ExpectedCost = ReferenceDijkstra(Graph, Agents[0].StartID, nullptr)[Agents[0].TargetID];
+			const bool bExpectedBlocked = ExpectedCost == INDEX_NONE;
+			if (Plans[0].bBlocked != bExpectedBlocked || (!bExpectedBlocked && Plans[0].EstimatedCost != ExpectedCost))
+			{
+				NumMismatches++;
+				UE_LOG(LogTemp, Error, TEXT("Validate Cooperative Paths: Single Agent | Graph Seed %d | %d -> %d | Estimate %lld, cheapest %lld"),
+					GraphSeed, Agents[0].StartID, Agents[0].TargetID, Plans[0].EstimatedCost, ExpectedCost);
+			}
+		}
+
+		// ==== Sub Section | Agents ==== //
+		// A few Turns: plan, check every Plan against the Graph and the Plans before it, move everyone by one Step
+		for (int32 Turn = 0; Turn < 3; Turn++)
+		{
+			TArray<FBytesAgentPlan> Plans;
+			UBytesMultiAgent::PlanCooperativePaths(Graph, Planner, Agents, Plans);
+
+			for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+			{
+				const FBytesAgentRequest& Agent = Agents[AgentID];
+				const FBytesAgentPlan& Plan = Plans[AgentID];
+				if (Plan.bBlocked)
+				{
+					// Blocked Agents wait on their Start
+					if (Plan.Steps.Num() != 1 || Plan.Steps[0] != Agent.StartID)
+					{
+						NumMismatches++;
+					UE_LOG(LogTemp, Error, TEXT("Validate Cooperative Paths: Graph Seed %d | Turn %d | blocked Agent %d leaves its Start"), GraphSeed, Turn, AgentID);
+					}
+					continue;
+				}
+
+				bool bValidSteps = !Plan.Steps.IsEmpty() && Plan.Steps[0] == Agent.StartID && Plan.Steps.Num() <= Planner.WindowSize + 1
+					&& (Plan.bReachesTarget ? Plan.Steps.Last() == Agent.TargetID : Plan.Steps.Num() == Planner.WindowSize + 1);
+				for (int32 Step = 1; bValidSteps && Step < Plan.Steps.Num(); Step++)
+				{
+					bValidSteps = Plan.Steps[Step] == Plan.Steps[Step - 1] || FindEdgeWeight(Graph, Plan.Steps[Step - 1], Plan.Steps[Step], nullptr) != INDEX_NONE;
+				}
+
+				// Blocked Agents included, they wait on their Start
+				int32 NumConflicts = 0;
+				for (int32 OtherID = 0; OtherID < Agents.Num(); OtherID++)
+				{
+					if (OtherID != AgentID)
+					{
+						NumConflicts += UBytesMultiAgent::CountConflicts({Plans[OtherID], Plan});
+					}
+				}
+
+				if (!bValidSteps || NumConflicts > 0)
+				{
+					NumMismatches++;
+					UE_LOG(LogTemp, Error, TEXT("Validate Cooperative Paths: Graph Seed %d | Turn %d | Agent %d %d -> %d | %d Steps%s, %d Conflicts"),
+						GraphSeed, Turn, AgentID, Agent.StartID, Agent.TargetID, Plan.Steps.Num(), bValidSteps ? TEXT("") : TEXT(" invalid"), NumConflicts);
+				}
+			}
+
+			for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+			{
+				if (Plans[AgentID].Steps.Num() > 1)
+				{
+					Agents[AgentID].StartID = Plans[AgentID].Steps[1];
+				}
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Validate Cooperative Paths: %d Graphs, %d Mismatches"), NumGraphs, NumMismatches);
+	return NumMismatches;
+}
+
+TArray<FBytesBenchmarkResult> UBytesPathfinderDebug::RunMultiAgentBenchmarks(const int32 Side, const int32 NumAgents, const int32 NumTurns, const int32 Seed)
+{
+	TArray<FBytesBenchmarkResult> Results;
+
+	FRandomStream Random(Seed);
+	FBytesGraph Graph = CreateSquareGridGraph(Side, Side, true);
+	for (int32 NodeID = 0; NodeID < Graph.Nodes.Num(); NodeID++)
+	{
+		if (Random.FRand() < 0.15f)
+		{
+			UBytesPathfinder::RemoveNode(Graph, NodeID);
+		}
+	}
+	const FString GraphName = FString::Printf(TEXT("Square %d, %d Agents"), Graph.Nodes.Num(), NumAgents);
+
+	// Distinct Starts, Targets may be shared
+	TArray<int32> FreeNodeIDs;
+	for (int32 NodeID = 0; NodeID < Graph.Nodes.Num(); NodeID++)
+	{
+		if (Graph.IsValidNode(NodeID))
+		{
+			FreeNodeIDs.Add(NodeID);
+		}
+	}
+	TArray<FBytesAgentRequest> InitialAgents;
+	while (InitialAgents.Num() < NumAgents && FreeNodeIDs.Num() > 1)
+	{
+		FBytesAgentRequest& Agent = InitialAgents.AddDefaulted_GetRef();
+		const int32 Index = Random.RandRange(0, FreeNodeIDs.Num() - 1);
+		Agent.StartID = FreeNodeIDs[Index];
+		FreeNodeIDs.RemoveAtSwap(Index);
+		Agent.TargetID = FreeNodeIDs[Random.RandRange(0, FreeNodeIDs.Num() - 1)];
+	}
+
+	// ==== Sub Section | Independent Paths ==== //
+	// One "GetPath()" per Agent and Turn, blind to the other Agents, moved like the cooperative Agents below.
+	// Counts the Pairs that would collide, Stats are summed over every Query
+	{
+		TArray<FBytesAgentRequest> Agents = InitialAgents;
+		FBytesSearchStats Stats;
+		int32 NumConflicts = 0;
+		double Seconds = 0.0;
+		for (int32 Turn = 0; Turn < NumTurns; Turn++)
+		{
+			TArray<FBytesAgentPlan> Plans;
+			const double StartTime = FPlatformTime::Seconds();
+			for (const FBytesAgentRequest& Agent : Agents)
+			{
+				FBytesAgentPlan& Plan = Plans.AddDefaulted_GetRef();
+				Graph.LastSearchStats = FBytesSearchStats();
+				Plan.Steps = UBytesPathfinder::GetPath(Graph, Agent.StartID, Agent.TargetID, true);
+				Plan.Steps.Insert(Agent.StartID, 0);
+				Stats += Graph.LastSearchStats;
+			}
+			Seconds += FPlatformTime::Seconds() - StartTime;
+			NumConflicts += UBytesMultiAgent::CountConflicts(Plans);
+
+			for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+			{
+				if (Plans[AgentID].Steps.Num() > 1)
+				{
+					Agents[AgentID].StartID = Plans[AgentID].Steps[1];
+				}
+			}
+		}
+
+		FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeResult(Graph, GraphName, TEXT("GetPath per Agent (Turn)"), NumTurns, Seconds));
+		Result.Stats = Stats;
+		Result.NumAgents = Agents.Num();
+		for (const FBytesAgentRequest& Agent : Agents)
+		{
+			Result.NumSolved += Agent.StartID == Agent.TargetID;
+		}
+		UE_LOG(LogTemp, Display, TEXT("Multi Agent Benchmark: independent Paths collide in %d Agent Pairs over %d Turns, %lld of %d Agents arrived"),
+			NumConflicts, NumTurns, Result.NumSolved, Agents.Num());
+	}
+
+	// ==== Sub Section | Cooperative Paths ==== //
+	// Every Turn plans all Agents and moves them by one Step. Solved counts the Agents on their Target at the End
+	for (const int32 WindowSize : {8, 16})
+	{
+		FBytesCooperativePlanner Planner;
+		Planner.WindowSize = WindowSize;
+		TArray<FBytesAgentRequest> Agents = InitialAgents;
+
+		FBytesSearchStats Stats;
+		int32 NumBlocked = 0;
+		double Seconds = 0.0;
+		for (int32 Turn = 0; Turn < NumTurns; Turn++)
+		{
+			TArray<FBytesAgentPlan> Plans;
+			const double StartTime = FPlatformTime::Seconds();
+			NumBlocked += UBytesMultiAgent::PlanCooperativePaths(Graph, Planner, Agents, Plans);
+			Seconds += FPlatformTime::Seconds() - StartTime;
+			Stats += Planner.LastStats;
+
+			for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+			{
+				if (Plans[AgentID].Steps.Num() > 1)
+				{
+					Agents[AgentID].StartID = Plans[AgentID].Steps[1];
+				}
+			}
+		}
+
+		const FString EntryPoint = FString::Printf(TEXT("PlanCooperativePaths (Window %d, Turn)"), WindowSize);
+		FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeResult(Graph, GraphName, *EntryPoint, NumTurns, Seconds));
+		Result.Stats = Stats;
+		Result.NumAgents = Agents.Num();
+		for (const FBytesAgentRequest& Agent : Agents)
+		{
+			Result.NumSolved += Agent.StartID == Agent.TargetID;
+		}
+		UE_LOG(LogTemp, Display, TEXT("Multi Agent Benchmark: Window %d | %lld of %d Agents arrived, %d blocked Agent Turns"), WindowSize, Result.NumSolved, Agents.Num(), NumBlocked);
+	}
+
+	LogBenchmarkResults(Results);
+	return Results;
+}
+
+int32 UBytesPathfinderDebug::ValidateConflictBasedSearch(const int32 NumGraphs, const int32 Seed)
+{
+	int32 NumMismatches = 0;
+	int32 NumUnsolvable = 0;
+	int32 NumGivenUp = 0;
+	for (int32 GraphIndex = 0; GraphIndex < NumGraphs; GraphIndex++)
+	{
+		const int32 GraphSeed = Seed + GraphIndex;
+		FRandomStream Random(GraphSeed);
+
+		// The Reference grows with the Nodes to the Power of the Agents, so keep both tiny
+		FBytesGraph Graph = Random.RandRange(0, 2) == 0 ? CreateValidationGraph(Random) : CreateSquareGridGraph(Random.RandRange(1, 4), Random.RandRange(2, 4), Random.RandRange(0, 1) == 1);
+		if (Graph.Nodes.Num() > 16)
+		{
+			continue;
+		}
+
+		FBytesConflictSolver Solver;
+		Solver.WaitCost = Random.RandRange(1, 150);
+
+		// Distinct Starts and distinct Targets
+		TArray<int32> Starts;
+		TArray<int32> Targets;
+		for (int32 NodeID = 0; NodeID < Graph.Nodes.Num(); NodeID++)
+		{
+			if (Graph.IsValidNode(NodeID))
+			{
+				Starts.Add(NodeID);
+				Targets.Add(NodeID);
+			}
+		}
+		TArray<FBytesAgentRequest> Agents;
+		const int32 NumAgents = FMath::Min(Random.RandRange(2, Graph.Nodes.Num() > 9 ? 2 : 3), Starts.Num());
+		while (Agents.Num() < NumAgents)
+		{
+			FBytesAgentRequest& Agent = Agents.AddDefaulted_GetRef();
+			const int32 StartIndex = Random.RandRange(0, Starts.Num() - 1);
+			const int32 TargetIndex = Random.RandRange(0, Targets.Num() - 1);
+			Agent.StartID = Starts[StartIndex];
+			Agent.TargetID = Targets[TargetIndex];
+			Starts.RemoveAtSwap(StartIndex);
+			Targets.RemoveAtSwap(TargetIndex);
+		}
+		if (Agents.IsEmpty())
+		{
+			continue;
+		}
+
+		const int64 ExpectedCost = ReferenceJointCost(Graph, Agents, Solver.WaitCost);
+		NumUnsolvable += ExpectedCost == INDEX_NONE;
+
+		for (const bool bReuseSearches : {true, false})
+		{
+			Solver.bReuseSearches = bReuseSearches;
+			TArray<FBytesAgentPlan> Plans;
+			const bool bFound = UBytesMultiAgent::PlanOptimalPaths(Graph, Solver, Agents, Plans);
+
+			// Unsolvable Instances only end once the Constraint Tree is full, so a full Tree is no Mismatch
+			if (!bFound)
+			{
+				NumGivenUp += Solver.LastConstraintNodes >= Solver.MaxConstraintNodes;
+				if (ExpectedCost != INDEX_NONE && Solver.LastConstraintNodes < Solver.MaxConstraintNodes)
+				{
+					NumMismatches++;
+					UE_LOG(LogTemp, Error, TEXT("Validate Conflict Based Search: Graph Seed %d | %d Agents | no Plans after %d Constraint Nodes, cheapest %lld"),
+						GraphSeed, Agents.Num(), Solver.LastConstraintNodes, ExpectedCost);
+				}
+				continue;
+			}
+
+			// Every Plan has to walk Edges or wait, end on its Target and cost what it estimates
+			int64 SumOfCosts = 0;
+			bool bValidPlans = true;
+			for (int32 AgentID = 0; AgentID < Agents.Num(); AgentID++)
+			{
+				const FBytesAgentPlan& Plan = Plans[AgentID];
+				bValidPlans &= !Plan.bBlocked && Plan.bReachesTarget && Plan.Steps[0] == Agents[AgentID].StartID && Plan.Steps.Last() == Agents[AgentID].TargetID;
+
+				int64 PlanCost = 0;
+				for (int32 Step = 1; bValidPlans && Step < Plan.Steps.Num(); Step++)
+				{
+					const int64 Weight = Plan.Steps[Step] == Plan.Steps[Step - 1] ? Solver.WaitCost : FindEdgeWeight(Graph, Plan.Steps[Step - 1], Plan.Steps[Step], nullptr);
+					bValidPlans &= Weight != INDEX_NONE;
+					PlanCost += Weight;
+				}
+				bValidPlans &= PlanCost == Plan.EstimatedCost;
+				SumOfCosts += Plan.EstimatedCost;
+			}
+
+			const int32 NumConflicts = UBytesMultiAgent::CountConflicts(Plans);
+			if (!bValidPlans || NumConflicts > 0 || SumOfCosts != ExpectedCost)
+			{
+				NumMismatches++;
+				UE_LOG(LogTemp, Error, TEXT("Validate Conflict Based Search: Graph Seed %d | %d Agents%s | Sum of Costs %lld, cheapest %lld | %d Conflicts%s"),
+					GraphSeed, Agents.Num(), bReuseSearches ? TEXT("") : TEXT(" without Reuse"), SumOfCosts, ExpectedCost, NumConflicts, bValidPlans ? TEXT("") : TEXT(", invalid Plans"));
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Validate Conflict Based Search: %d Graphs, %d unsolvable, %d Searches with a full Constraint Tree, %d Mismatches"),
+		NumGraphs, NumUnsolvable, NumGivenUp, NumMismatches);
+	return NumMismatches;
+}
+
+TArray<FBytesBenchmarkResult> UBytesPathfinderDebug::RunConflictBasedSearchBenchmarks(const int32 Side, const int32 MaxAgents, const int32 NumInstances, const int32 Seed)
+{
+	TArray<FBytesBenchmarkResult> Results;
+
+	// Four connected Room with 10% removed Nodes, like a Tactics Map
+	FRandomStream Random(Seed);
+	FBytesGraph Graph = CreateSquareGridGraph(Side, Side, false);
+	for (int32 NodeID = 0; NodeID < Graph.Nodes.Num(); NodeID++)
+	{
+		if (Random.FRand() < 0.1f)
+		{
+			UBytesPathfinder::RemoveNode(Graph, NodeID);
+		}
+	}
+	TArray<int32> ValidNodeIDs;
+	for (int32 NodeID = 0; NodeID < Graph.Nodes.Num(); NodeID++)
+	{
+		if (Graph.IsValidNode(NodeID))
+		{
+			ValidNodeIDs.Add(NodeID);
+		}
+	}
+
+	for (int32 NumAgents = 2; NumAgents <= FMath::Min(MaxAgents, ValidNodeIDs.Num()); NumAgents = NumAgents < MaxAgents && NumAgents * 2 > MaxAgents ? MaxAgents : NumAgents * 2)
+	{
+		// Same Instances for both Settings, Agents that can not reach their Target get other Nodes.
+		// Split Rooms may leave no reachable Pair, so give up after a few Attempts per Agent
+		const int32 MaxAttempts = NumAgents * 64;
+		TArray<TArray<FBytesAgentRequest>> Instances;
+		int32 NumPlacedAgents = 0;
+		for (int32 Instance = 0; Instance < NumInstances; Instance++)
+		{
+			TArray<int32> Starts = ValidNodeIDs;
+			TArray<int32> Targets = ValidNodeIDs;
+			TArray<FBytesAgentRequest>& Agents = Instances.AddDefaulted_GetRef();
+			for (int32 Attempt = 0; Attempt < MaxAttempts && Agents.Num() < NumAgents; Attempt++)
+			{
+				const int32 StartIndex = Random.RandRange(0, Starts.Num() - 1);
+				const int32 TargetIndex = Random.RandRange(0, Targets.Num() - 1);
+				if (UBytesPathfinder::GetPath(Graph, Starts[StartIndex], Targets[TargetIndex], true).IsEmpty() && Starts[StartIndex] != Targets[TargetIndex])
+				{
+					continue;
+				}
+				Agents.Add({Starts[StartIndex], Targets[TargetIndex]});
+				Starts.RemoveAtSwap(StartIndex);
+				Targets.RemoveAtSwap(TargetIndex);
+			}
+			NumPlacedAgents += Agents.Num();
+		}
+		if (NumPlacedAgents < NumAgents * NumInstances)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Conflict Based Search Benchmark: %d Agents | placed only %d of %d Agents over %d Instances"),
+				NumAgents, NumPlacedAgents, NumAgents * NumInstances, NumInstances);
+		}
+
+		for (const bool bReuseSearches : {true, false})
+		{
+			FBytesConflictSolver Solver;
+			Solver.bReuseSearches = bReuseSearches;
+
+			FBytesSearchStats Stats;
+			int64 SumOfCosts = 0;
+			int32 NumSolved = 0;
+			int64 NumConstraintNodes = 0;
+			int64 NumSearches = 0;
+			int64 NumReusedSearches = 0;
+			const double StartTime = FPlatformTime::Seconds();
+			for (const TArray<FBytesAgentRequest>& Agents : Instances)
+			{
+				TArray<FBytesAgentPlan> Plans;
+				if (UBytesMultiAgent::PlanOptimalPaths(Graph, Solver, Agents, Plans))
+				{
+					NumSolved++;
+					for (const FBytesAgentPlan& Plan : Plans)
+					{
+						SumOfCosts += Plan.EstimatedCost;
+					}
+				}
+				Stats += Solver.LastStats;
+				NumConstraintNodes += Solver.LastConstraintNodes;
+				NumSearches += Solver.LastSearches;
+				NumReusedSearches += Solver.LastReusedSearches;
+			}
+
+			const FString GraphName = FString::Printf(TEXT("Room %d, %d Agents"), Side, NumAgents);
+			FBytesBenchmarkResult& Result = Results.Add_GetRef(MakeResult(Graph, GraphName, bReuseSearches ? TEXT("PlanOptimalPaths") : TEXT("PlanOptimalPaths (no Reuse)"),
+				NumInstances, FPlatformTime::Seconds() - StartTime));
+			Result.Stats = Stats;
+			Result.NumAgents = NumPlacedAgents;
+			Result.NumSolved = NumSolved;
+			Result.SumOfCosts = SumOfCosts;
+			UE_LOG(LogTemp, Display, TEXT("Conflict Based Search Benchmark: %d Agents%s | %d of %d solved, %lld Constraint Nodes, %lld Searches, %lld reused"),
+				NumAgents, bReuseSearches ? TEXT("") : TEXT(" without Reuse"), NumSolved, NumInstances, NumConstraintNodes, NumSearches, NumReusedSearches);
+		}
+	}
+
+	LogBenchmarkResults(Results);
+	return Results;
+}
+
+bool UBytesPathfinderDebug::WriteTraceFile(const FString& FilePath)
+{
+	return BytesTrace::WriteChromeTrace(FilePath);
+}
@@ -0,0 +1,248 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "Pathfinding/BytesPathfinder.h"
+#include "BytesPathfinderDebug.generated.h"
+
+UENUM(BlueprintType)
+enum class EBytesBenchmarkGraph : uint8
+{
+	// 8 connected Square Grid
+	Square,
+	// 6 connected Hex Grid
+	Hexagonal,
+	// Random Points, connected to every Point within a Radius
+	RandomGeometric,
+	// Jittered Towns with slow local Roads and fast Highways every few Rows/Columns
+	Road,
+};
+
+// Result of one Entry Point on one Graph
+USTRUCT(BlueprintType)
+struct FBytesBenchmarkResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	FString Name;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int32 NumNodes = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int32 NumEdges = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int32 NumQueries = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	double TotalSeconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	double MicrosecondsPerQuery = 0.0;
+
+	// Summed over all Queries, empty for Entry Points that do not search
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	FBytesSearchStats Stats;
+
+	// Nodes, Edges and stored Search State
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int64 GraphBytes = 0;
+
+	// Temporary Memory of one Query: Search State, Heap and Closed List
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int64 SearchBytes = 0;
+
+	// Summed over all reached Targets, only filled by Entry Points that compare Path Shapes
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int64 PathCost = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int64 PathNodes = 0;
+
+	// Agents summed over all Queries, only filled by Multi Agent Entry Points
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int64 NumAgents = 0;
+
+	// Queries with a Plan for every Agent, or Agents on their Target. Only filled by Multi Agent Entry Points
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int64 NumSolved = 0;
+
+	// Summed Plan Costs of the solved Queries, only filled by Multi Agent Entry Points
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int64 SumOfCosts = 0;
+};
+
+// Summary of a MovingAI Scenario File run through "UBytesPathfinder::GetPath()"
+USTRUCT(BlueprintType)
+struct FBytesMovingAIResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int32 NumScenarios = 0;
+
+	// Scenarios where a Path has been found
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int32 NumSolved = 0;
+
+	// Scenarios that have a Solution, but no Path has been found
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	int32 NumFailed = 0;
+
+	// Relative Difference to the published optimal Length, 0.01 means 1% longer
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	double MeanOptimalityGap = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	double MaxOptimalityGap = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	double TotalSeconds = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Pathfinder|Debug")
+	double QueriesPerSecond = 0.0;
+};
+
+/*
+ * Synthetic Graphs and Benchmarks for the Pathfinder.
+ * Nothing in here is needed at Runtime, it exists to measure Changes.
+ */
+UCLASS()
+class BYTESHEXGRIDPLUGIN_API UBytesPathfinderDebug : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+	/*
+	 * Square Grid with 100 Units between Cells. Straight Edges cost 100, diagonal Edges 142,
+	 * so the Euclidean Heuristic never overestimates.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static FBytesGraph CreateSquareGridGraph(const int32 Width, const int32 Height, const bool bDiagonal = true);
+
+	/*
+	 * Pointy Top Hex Grid in Offset Layout, 100 Units between Cell Centers, every Edge costs 100.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static FBytesGraph CreateHexGridGraph(const int32 Width, const int32 Height);
+
+	/*
+	 * NumNodes random Points, each connected to every Point within the Radius that gives roughly AverageDegree Neighbours.
+	 * Weights are the rounded up Distances.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static FBytesGraph CreateRandomGeometricGraph(const int32 NumNodes, const float AverageDegree, const int32 Seed);
+
+	/*
+	 * Towns on a jittered Grid. Local Roads connect some Towns to their right and lower Neighbour
+	 * and cost 1.5 times their Length, Highways on every 8th Row and Column cost their Length.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static FBytesGraph CreateRoadGraph(const int32 NumNodes, const int32 Seed);
+
+	// Creates one of the Graphs above with about NumNodes Nodes
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static FBytesGraph CreateBenchmarkGraph(const EBytesBenchmarkGraph GraphKind, const int32 NumNodes, const int32 Seed);
+
+	/*
+	 * Runs NumQueries random Queries through FindPath, GetPath, FindPathsToNodes, GetNodesInRange
+	 * and AddOrSetEdge on the Graph. The Graph itself is not modified.
+	 * The Import Rows rebuild the Graph from its Edge List through "BuildGraph()" and through one "AddOrSetEdge()" per Edge, timed per Edge.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static TArray<FBytesBenchmarkResult> RunBenchmarks(const FBytesGraph& Graph, const FString& GraphName, const int32 NumQueries, const int32 Seed);
+
+	/*
+	 * Runs "RunBenchmarks()" on every Benchmark Graph Kind for every Size and logs a Table.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static TArray<FBytesBenchmarkResult> RunBenchmarkSuite(const TArray<int32>& NodeCounts, const int32 NumQueries, const int32 Seed);
+
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static void LogBenchmarkResults(const TArray<FBytesBenchmarkResult>& Results);
+
+	/*
+	 * Loads a MovingAI ".map" File (https://movingai.com/benchmarks/formats.html) as 8 connected Square Grid.
+	 * Only passable Cells ('.', 'G', 'S') become Nodes. CellToNode maps Y * Width + X to the NodeID, or -1.
+	 * Cells are 1000 Units apart, straight Moves cost 1000 and diagonal Moves 1415. Diagonals may not cut Corners.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static bool LoadMovingAIMap(const FString& MapFilePath, FBytesGraph& OutGraph, TArray<int32>& OutCellToNode, int32& OutWidth, int32& OutHeight);
+
+	/*
+	 * Loads the Map and runs every Scenario of the ".scen" File through "GetPath()".
+	 * Compares the octile Length of every Path against the published optimal Length.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static FBytesMovingAIResult RunMovingAIScenarios(const FString& MapFilePath, const FString& ScenarioFilePath);
+
+	/*
+	 * Differential Test: builds NumGraphs random Graphs (directed and asymmetric Edges, removed Nodes, every second Graph
+	 * with Weights below the Distance) and checks every Solver against a naive reference Dijkstra.
+	 * Every returned Path has to exist in the Graph and cost exactly the reference Cost,
+	 * Weighted A* at most its Weight times it and Anytime A* at most its reported Bound times it.
+	 * The Heuristic Scale has to match the remaining Edges after "CompactGraph()".
+	 * Logs every Mismatch with the Seed to reproduce it, returns the Number of Mismatches.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static int32 ValidateSolvers(const int32 NumGraphs, const int32 QueriesPerGraph, const int32 Seed);
+
+	/*
+	 * Differential Test for the implicit Grids in "BytesGridGraph.h": random Square and Hex Grids with blocked
+	 * and expensive Cells. Every Grid Solver is checked against the reference Dijkstra on the explicit Copy of the Grid,
+	 * the Walkable Bit Scans, Rects and Lines of Sight against Cell by Cell Loops, the Parents of any Angle Searches against their Lines,
+	 * the SIMD Kernel against the scalar one for every Cell. Returns the Number of Mismatches.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static int32 ValidateGridSolvers(const int32 NumGrids, const int32 QueriesPerGrid, const int32 Seed);
+
+	/*
+	 * Same Queries on implicit Side x Side Grids (4, 8 and 6 connected) and their explicit Copies:
+	 * "FindPath" on the Graph, the generic A* Loop on the Grid and "BytesSearch::GridAStar()" with the scalar and the SIMD Kernel.
+	 * Short Queries once with the dense and once with the sparse Search State.
+	 * BlockedChance (0 - 1) of all Cells are blocked.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static TArray<FBytesBenchmarkResult> RunGridBenchmarks(const int32 Side, const float BlockedChance, const int32 NumQueries, const int32 Seed);
+
+	/*
+	 * Differential Test for "UBytesMultiAgent::PlanCooperativePaths()" on random Graphs and crowded small Grids.
+	 * A single Agent has to estimate the cheapest Path. With many Agents every Plan has to follow Edges or wait,
+	 * and must not meet any other Agent on a Node or swap Nodes with one. Runs a few Turns each. Returns the Number of Mismatches.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static int32 ValidateCooperativePaths(const int32 NumGraphs, const int32 AgentsPerGraph, const int32 Seed);
+
+	/*
+	 * NumAgents on a Side x Side Square Grid Graph with 15% removed Nodes for NumTurns Turns.
+	 * One independent "GetPath()" per Agent against Cooperative A* with a Window of 8 and 16 Turns, Times are per Turn.
+	 * Logs how many Agent Pairs the independent Paths would collide in and how many cooperative Agents arrived.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static TArray<FBytesBenchmarkResult> RunMultiAgentBenchmarks(const int32 Side, const int32 NumAgents, const int32 NumTurns, const int32 Seed);
+
+	/*
+	 * Differential Test for "UBytesMultiAgent::PlanOptimalPaths()" against a Dijkstra over the joint State of all Agents.
+	 * Two or three Agents on tiny random Graphs and Grids, with and without reused Searches. Plans have to follow Edges or wait,
+	 * be free of Conflicts and have the lowest Sum of Costs. Returns the Number of Mismatches.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static int32 ValidateConflictBasedSearch(const int32 NumGraphs, const int32 Seed);
+
+	/*
+	 * NumInstances random Instances per Agent Count from 2 doubling up to MaxAgents, on a four connected Side x Side Room with 10% removed Nodes.
+	 * With and without reused Searches. Gives up placing an Agent after a few Attempts, so crowded Rooms may get fewer Agents than asked for.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static TArray<FBytesBenchmarkResult> RunConflictBasedSearchBenchmarks(const int32 Side, const int32 MaxAgents, const int32 NumInstances, const int32 Seed);
+
+	/*
+	 * Writes all Trace Events recorded since the last Call as Chrome Trace JSON, see "BytesPathfinderTrace.h".
+	 * Only Builds with BYTES_PATHFINDER_TRACE record Events, otherwise the File stays empty.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Pathfinder|Debug")
+	static bool WriteTraceFile(const FString& FilePath);
+};
@@ -0,0 +1,1493 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Pathfinding/BytesPathfinder.h"
+
+// Unreached Nodes keep this GCost, no Path can cost this much
+constexpr int32 INITIAL_DISTANCE = MAX_int32;
+
+// Stat Updates inside the Search Templates, expect an optional "FBytesSearchStats* Stats" in Scope.
+// Compiled out completely without BYTES_PATHFINDER_STATS
+#if BYTES_PATHFINDER_STATS
+	#define BYTES_SEARCH_STAT(Statement) if (Stats) { Statement; }
+	#define BYTES_SEARCH_STAT_TIMER() const BytesSearch::FStatsTimer StatsTimer(Stats)
+#else
+	#define BYTES_SEARCH_STAT(Statement)
+	#define BYTES_SEARCH_STAT_TIMER()
+#endif
+
+// ==== Section | Graph Accessors ==== //
+
+/*
+ * The Search Templates below do not care where Nodes and Edges are stored.
+ * Every Graph Accessor offers the same small Interface:
+ *
+ * int32 NumNodes() const
+ * FVector2D GetLocation(const int32 NodeID) const
+ * double GetHeuristicScale() const -> see "FBytesGraph::HeuristicScale"
+ * void ForEachNeighbour(const int32 NodeID, Functor) const -> calls Functor(NeighbourID, Weight)
+ *
+ * Accessors that support backwards Searches also offer:
+ * void ForEachIncomingNeighbour(const int32 NodeID, Functor) const -> calls Functor(SourceID, Weight)
+ *
+ * Accessors that support Cost Profiles also offer:
+ * uint8 GetTerrainClass(const int32 NodeID) const
+ * int32 GetNumTerrainClasses() const
+ */
+struct FBytesGraphAccessor
+{
+	explicit FBytesGraphAccessor(const FBytesGraph& InGraph)
+		: Graph(InGraph)
+	{
+	}
+
+	int32 NumNodes() const
+	{
+		return Graph.Nodes.Num();
+	}
+
+	FVector2D GetLocation(const int32 NodeID) const
+	{
+		return Graph.Nodes[NodeID].Location2D;
+	}
+
+	double GetHeuristicScale() const
+	{
+		return Graph.HeuristicScale;
+	}
+
+	uint8 GetTerrainClass(const int32 NodeID) const
+	{
+		return Graph.Nodes[NodeID].TerrainClass;
+	}
+
+	int32 GetNumTerrainClasses() const
+	{
+		return Graph.NumTerrainClasses;
+	}
+
+	template<typename FunctorType>
+	void ForEachNeighbour(const int32 NodeID, FunctorType&& Functor) const
+	{
+		VisitEdges(Graph.Edges[NodeID].NeighbouringEdges, Functor);
+	}
+
+	template<typename FunctorType>
+	void ForEachIncomingNeighbour(const int32 NodeID, FunctorType&& Functor) const
+	{
+		// Undirected Graphs are their own Reverse
+		const TArray<FBytesEdges>& IncomingEdges = Graph.bDirected ? Graph.ReverseEdges : Graph.Edges;
+		VisitEdges(IncomingEdges[NodeID].NeighbouringEdges, Functor);
+	}
+
+private:
+	const FBytesGraph& Graph;
+
+	template<typename FunctorType>
+	void VisitEdges(const TArray<FBytesEdge>& NeighbouringEdges, FunctorType& Functor) const
+	{
+		// Edges into removed Nodes stay until the Graph gets compacted, only pay for the Check when there are any
+		if (Graph.NumRemovedNodes == 0)
+		{
+			for (const FBytesEdge& Edge : NeighbouringEdges)
+			{
+				Functor(Edge.NodeID, Edge.Weight);
+			}
+			return;
+		}
+
+		for (const FBytesEdge& Edge : NeighbouringEdges)
+		{
+			if (!Graph.Nodes[Edge.NodeID].bRemoved)
+			{
+				Functor(Edge.NodeID, Edge.Weight);
+			}
+		}
+	}
+};
+
+// Flips every Edge of another Accessor, so a forward Search on it runs backwards on the original Graph
+template<typename GraphType>
+struct TBytesReversedGraph
+{
+	explicit TBytesReversedGraph(const GraphType& InGraph)
+		: Graph(InGraph)
+	{
+	}
+
+	int32 NumNodes() const
+	{
+		return Graph.NumNodes();
+	}
+
+	FVector2D GetLocation(const int32 NodeID) const
+	{
+		return Graph.GetLocation(NodeID);
+	}
+
+	double GetHeuristicScale() const
+	{
+		return Graph.GetHeuristicScale();
+	}
+
+	template<typename FunctorType>
+	void ForEachNeighbour(const int32 NodeID, FunctorType&& Functor) const
+	{
+		Graph.ForEachIncomingNeighbour(NodeID, Forward<FunctorType>(Functor));
+	}
+
+	template<typename FunctorType>
+	void ForEachIncomingNeighbour(const int32 NodeID, FunctorType&& Functor) const
+	{
+		Graph.ForEachNeighbour(NodeID, Forward<FunctorType>(Functor));
+	}
+
+private:
+	const GraphType& Graph;
+};
+
+/*
+ * Scales every Edge of another Accessor by a Cost Profile, see "FBytesCostProfile".
+ * The Terrain of the Node an Edge leads into decides its Cost, Edges into impassable Terrain are skipped.
+ */
+template<typename GraphType>
+struct TBytesProfiledGraph
+{
+	TBytesProfiledGraph(const GraphType& InGraph, const FBytesCostProfile& InProfile)
+		: Graph(InGraph)
+		, Profile(InProfile)
+		, HeuristicScale(InGraph.GetHeuristicScale() * InProfile.GetCheapestPercent(InGraph.GetNumTerrainClasses()) / 100.0)
+	{
+	}
+
+	int32 NumNodes() const
+	{
+		return Graph.NumNodes();
+	}
+
+	FVector2D GetLocation(const int32 NodeID) const
+	{
+		return Graph.GetLocation(NodeID);
+	}
+
+	// No Edge can get cheaper than the cheapest Terrain makes it
+	double GetHeuristicScale() const
+	{
+		return HeuristicScale;
+	}
+
+	template<typename FunctorType>
+	void ForEachNeighbour(const int32 NodeID, FunctorType&& Functor) const
+	{
+		Graph.ForEachNeighbour(NodeID, [this, &Functor](const int32 NeighbourID, const int32 Weight)
+		{
+			const int32 Percent = Profile.GetCostPercent(Graph.GetTerrainClass(NeighbourID));
+			if (Percent >= 0)
+			{
+				Functor(NeighbourID, ScaleWeight(Weight, Percent));
+			}
+		});
+	}
+
+	// Every Incoming Edge leads into NodeID, so they all share its Terrain
+	template<typename FunctorType>
+	void ForEachIncomingNeighbour(const int32 NodeID, FunctorType&& Functor) const
+	{
+		const int32 Percent = Profile.GetCostPercent(Graph.GetTerrainClass(NodeID));
+		if (Percent < 0)
+		{
+			return;
+		}
+
+		Graph.ForEachIncomingNeighbour(NodeID, [&Functor, Percent](const int32 SourceID, const int32 Weight)
+		{
+			Functor(SourceID, ScaleWeight(Weight, Percent));
+		});
+	}
+
+	// Rounded up, so the floored Heuristic never overestimates
+	static int32 ScaleWeight(const int32 Weight, const int32 Percent)
+	{
+		const int64 Scaled = (int64(Weight) * Percent + 99) / 100;
+		return int32(FMath::Min<int64>(Scaled, MAX_int32));
+	}
+
+private:
+	const GraphType& Graph;
+	const FBytesCostProfile& Profile;
+	double HeuristicScale;
+};
+
+// ==== Section | Search Policies ==== //
+
+/*
+ * The Search Templates take the Heuristic and the Open List as Template Parameters too,
+ * so every Combination gets its own Inner Loop with Neighbours and Heuristic inlined.
+ *
+ * A Heuristic Policy is a small Functor:
+ * int32 operator()(const GraphType& Graph, const int32 NodeID, const int32 TargetID) const
+ * It must never overestimate and should be consistent, otherwise Nodes would have to be reopened.
+ *
+ * A Queue Policy orders Node ID's by the FCost in the Search State, ties by the lower HCost:
+ * QueueType(FBytesSearchState& State, const int32 NumNodes)
+ * bool Push(const int32 NodeID) -> NodeID got cheaper, returns true if it was only moved inside the Queue
+ * int32 Pop() -> cheapest Node, or -1 once the Queue is empty
+ * int32 Num() const
+ *
+ * A Line of Sight Policy tells any Angle Searches if two Nodes may be connected straight and what that costs:
+ * bool operator()(const GraphType& Graph, const int32 FromID, const int32 ToID, int32& OutCost) const
+ * OutCost must never be below the scaled Euclidean Distance, so the Heuristic stays admissible.
+ */
+
+// Scaled Euclidean Distance, the Default for every Graph with meaningful Locations
+struct FBytesEuclideanHeuristic
+{
+	// Floored, so it never overestimates
+	template<typename GraphType>
+	int32 operator()(const GraphType& Graph, const int32 NodeID, const int32 TargetID) const
+	{
+		return FMath::FloorToInt32(Graph.GetHeuristicScale() * FVector2D::Distance(Graph.GetLocation(NodeID), Graph.GetLocation(TargetID)));
+	}
+};
+
+// No Guess at all, turns A* into Dijkstra. Does not need a Target
+struct FBytesZeroHeuristic
+{
+	template<typename GraphType>
+	int32 operator()(const GraphType& Graph, const int32 NodeID, const int32 TargetID) const
+	{
+		return 0;
+	}
+};
+
+/*
+ * Remaining Cost the Accessor already knows for every Node, e.g. from a backwards Dijkstra. Does not need a Target.
+ * The Accessor has to offer: int32 GetTargetCost(const int32 NodeID) const
+ */
+struct FBytesTargetCostHeuristic
+{
+	template<typename GraphType>
+	int32 operator()(const GraphType& Graph, const int32 NodeID, const int32 TargetID) const
+	{
+		return Graph.GetTargetCost(NodeID);
+	}
+};
+
+/*
+ * Line of Sight for Graphs without Obstacle Geometry: walks from FromID towards ToID, every Step to the Neighbour
+ * closest to ToID that stays within half a Step of the Line. Blocked Cells or removed Nodes leave Gaps no Walk gets across.
+ * The straight Line costs as much per Unit as the walked Edges, rounded up.
+ * Greedy, so a winding Chain of Edges along the Line may be missed. That only costs a Shortcut, never a wrong Path.
+ */
+struct FBytesGraphLineOfSight
+{
+	template<typename GraphType>
+	bool operator()(const GraphType& Graph, const int32 FromID, const int32 ToID, int32& OutCost) const
+	{
+		const FVector2D From = Graph.GetLocation(FromID);
+		const FVector2D To = Graph.GetLocation(ToID);
+		const FVector2D Direction = To - From;
+		const double Length = Direction.Size();
+		if (Length <= 0.0)
+		{
+			return false;
+		}
+
+		int64 WalkWeight = 0;
+		double WalkLength = 0.0;
+		int32 CurrentID = FromID;
+		FVector2D Current = From;
+		double CurrentDistance = Length;
+		while (CurrentID != ToID)
+		{
+			int32 NextID = INDEX_NONE;
+			int32 NextWeight = 0;
+			FVector2D Next = Current;
+			double NextDistance = CurrentDistance;
+
+			// Every Step gets closer to ToID, so the Walk always ends
+			Graph.ForEachNeighbour(CurrentID, [&](const int32 NeighbourID, const int32 Weight)
+			{
+				const FVector2D Location = Graph.GetLocation(NeighbourID);
+				const double Distance = FVector2D::Distance(Location, To);
+				if (Distance >= NextDistance)
+				{
+					return;
+				}
+
+				const double Deviation = FMath::Abs(FVector2D::CrossProduct(Direction, Location - From)) / Length;
+				if (Deviation > 0.5 * FVector2D::Distance(Current, Location))
+				{
+					return;
+				}
+
+				NextID = NeighbourID;
+				NextWeight = Weight;
+				Next = Location;
+				NextDistance = Distance;
+			});
+
+			if (NextID == INDEX_NONE)
+			{
+				return false;
+			}
+
+			WalkWeight += NextWeight;
+			WalkLength += FVector2D::Distance(Current, Next);
+			CurrentID = NextID;
+			Current = Next;
+			CurrentDistance = NextDistance;
+		}
+
+		// The Tolerance keeps straight Walks from costing more than their Edges, Locations are not exact
+		OutCost = int32(FMath::Min<double>(FMath::CeilToDouble(Length * WalkWeight / WalkLength - UE_KINDA_SMALL_NUMBER), INITIAL_DISTANCE - 1));
+		return true;
+	}
+};
+
+/*
+ * Weighted A*: another Heuristic multiplied by Weight >= 1. Overestimates on Purpose, so the Search heads
+ * straight for the Target and expands far fewer Nodes. Paths cost at most Weight times the cheapest Path.
+ */
+template<typename HeuristicType>
+struct TBytesInflatedHeuristic
+{
+	explicit TBytesInflatedHeuristic(const double InWeight = 1.0, const HeuristicType& InHeuristic = HeuristicType())
+		: Weight(FMath::Max(InWeight, 1.0))
+		, Heuristic(InHeuristic)
+	{
+	}
+
+	template<typename GraphType>
+	int32 operator()(const GraphType& Graph, const int32 NodeID, const int32 TargetID) const
+	{
+		return Inflate(Heuristic(Graph, NodeID, TargetID));
+	}
+
+	int32 Inflate(const int32 Estimate) const
+	{
+		return int32(FMath::Min<double>(Estimate * Weight, INITIAL_DISTANCE - 1));
+	}
+
+	double Weight;
+	HeuristicType Heuristic;
+};
+
+// Binary Heap with Decrease Key, every Node is queued at most once. The Search State holds its Heap Indices
+struct FBytesIndexedQueue
+{
+	FBytesIndexedQueue(FBytesSearchState& State, const int32 NumNodes)
+		: Heap(State, NumNodes)
+	{
+	}
+
+	bool Push(const int32 NodeID)
+	{
+		if (Heap.Contains(NodeID))
+		{
+			Heap.UpdateItem(NodeID);
+			return true;
+		}
+		Heap.Add(NodeID);
+		return false;
+	}
+
+	int32 Pop()
+	{
+		return Heap.IsNotEmpty() ? Heap.RemoveFirst() : INDEX_NONE;
+	}
+
+	int32 Num() const
+	{
+		return Heap.Num();
+	}
+
+private:
+	FBytesPathfindingHeap Heap;
+};
+
+/*
+ * Binary Heap without Decrease Key: a cheaper Cost pushes another Entry and the old one gets skipped once it is popped.
+ * Pushes are cheaper and no Heap Indices have to be kept, in Exchange for a larger Heap.
+ * Costs only ever get lower, so an Entry is stale as soon as its GCost differs from the Search State.
+ * Needs nothing per Node, so it also works with "FBytesSparseSearchState".
+ */
+template<typename StateType>
+struct TBytesLazyQueue
+{
+	TBytesLazyQueue(StateType& InState, const int32 NumNodes)
+		: State(InState)
+	{
+		Entries.Reserve(FMath::Min(NumNodes, 1024));
+	}
+
+	bool Push(const int32 NodeID)
+	{
+		Entries.HeapPush({State.FCost(NodeID), State.HCost[NodeID], State.GCost[NodeID], NodeID}, FEntry::HasHigherPriority);
+		return false;
+	}
+
+	int32 Pop()
+	{
+		while (!Entries.IsEmpty())
+		{
+			FEntry Entry;
+			Entries.HeapPop(Entry, FEntry::HasHigherPriority);
+			if (Entry.GCost == State.GCost[Entry.NodeID])
+			{
+				return Entry.NodeID;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	// Includes stale Entries
+	int32 Num() const
+	{
+		return Entries.Num();
+	}
+
+private:
+	struct FEntry
+	{
+		int64 FCost;
+		int32 HCost;
+		int32 GCost;
+		int32 NodeID;
+
+		// Same Order as "FBytesPathfindingHeap"
+		static bool HasHigherPriority(const FEntry& A, const FEntry& B)
+		{
+			return A.FCost < B.FCost || A.FCost == B.FCost && A.HCost < B.HCost;
+		}
+	};
+
+	StateType& State;
+	TArray<FEntry> Entries;
+};
+
+using FBytesLazyQueue = TBytesLazyQueue<FBytesSearchState>;
+using FBytesSparseLazyQueue = TBytesLazyQueue<FBytesSparseSearchState>;
+
+// ==== Section | Search Templates ==== //
+
+namespace BytesSearch
+{
+	// Adds the Wall Time of its Scope to the Stats
+	struct FStatsTimer
+	{
+		explicit FStatsTimer(FBytesSearchStats* InStats)
+			: Stats(InStats)
+			, StartCycles(InStats ? FPlatformTime::Cycles64() : 0)
+		{
+		}
+
+		~FStatsTimer()
+		{
+			if (Stats)
+			{
+				Stats->WallTimeSeconds += (FPlatformTime::Cycles64() - StartCycles) * FPlatformTime::GetSecondsPerCycle64();
+			}
+		}
+
+	private:
+		FBytesSearchStats* Stats;
+		uint64 StartCycles;
+	};
+
+	// Scaled Euclidean Distance between two Nodes, floored so it never overestimates
+	template<typename GraphType>
+	int32 HeuristicDistance(const GraphType& Graph, const int32 StartID, const int32 TargetID)
+	{
+		return FBytesEuclideanHeuristic()(Graph, StartID, TargetID);
+	}
+
+	// Closed List of "BestFirstSearch()": a Bit per Node next to the dense State, a Flag inside the Slots of the sparse one
+	inline TBitArray<> MakeClosedSet(const FBytesSearchState& State, const int32 NumNodes)
+	{
+		return TBitArray<>(false, NumNodes);
+	}
+
+	inline decltype(FBytesSparseSearchState::Closed)& MakeClosedSet(FBytesSparseSearchState& State, const int32 NumNodes)
+	{
+		return State.Closed;
+	}
+
+	// Sum of Cost and Weight, or INITIAL_DISTANCE if it would reach it
+	FORCEINLINE int32 AddCost(const int32 Cost, const int32 Weight)
+	{
+		const int64 Sum = int64(Cost) + Weight;
+		return Sum < INITIAL_DISTANCE ? int32(Sum) : INITIAL_DISTANCE;
+	}
+
+	/*
+	 * Best First Search from StartID, the Core of A* and Dijkstra. Writes Costs and Parents into State.
+	 * Stops once TargetID is expanded, a TargetID of -1 expands every reachable Node.
+	 * Returns true if the Target has been reached. Stats is optional.
+	 * State is "FBytesSearchState" or "FBytesSparseSearchState" with a Queue that works on it.
+	 */
+	template<typename HeuristicType, typename QueueType, typename GraphType, typename StateType>
+	bool BestFirstSearch(const GraphType& Graph, StateType& State, const int32 StartID, const int32 TargetID, FBytesSearchStats* Stats = nullptr, const HeuristicType& Heuristic = HeuristicType())
+	{
+		BYTES_SEARCH_STAT_TIMER();
+
+		const int32 NumNodes = Graph.NumNodes();
+		State.Init(NumNodes, INITIAL_DISTANCE);
+
+		// Declare "Open List" and "Closed List"
+		// Node ID's are dense indices, so the Closed List is a single Bit per Node instead of a hashed Set. The sparse State keeps it in its Slots
+		QueueType OpenSet(State, NumNodes);
+		auto&& ClosedSet = MakeClosedSet(State, NumNodes);
+
+		// Add First Node
+		State.GCost[StartID] = 0;
+		State.HCost[StartID] = Heuristic(Graph, StartID, TargetID);
+		OpenSet.Push(StartID);
+		BYTES_SEARCH_STAT(Stats->HeapPushes++);
+		BYTES_SEARCH_STAT(Stats->PeakOpenSetSize = FMath::Max<int64>(Stats->PeakOpenSetSize, 1));
+
+		while (true)
+		{
+			// Get Current Node
+			const int32 CurrentID = OpenSet.Pop();
+			if (CurrentID == INDEX_NONE)
+			{
+				return false;
+			}
+
+			// Add Current Node to Closed List
+			ClosedSet[CurrentID] = true;
+			BYTES_SEARCH_STAT(Stats->HeapPops++);
+			BYTES_SEARCH_STAT(Stats->NodesExpanded++);
+
+			// Check if Current is Target
+			if (CurrentID == TargetID)
+			{
+				return true;
+			}
+
+			const int32 CurrentCost = State.GCost[CurrentID];
+
+			// Iterate over Neighbours
+			Graph.ForEachNeighbour(CurrentID, [&](const int32 NeighbourID, const int32 Weight)
+			{
+				BYTES_SEARCH_STAT(Stats->NodesGenerated++);
+
+				// if Closed List Contains Neighbour, return
+				if (ClosedSet[NeighbourID])
+				{
+					return;
+				}
+
+				// Calculate Cost to Neighbour
+				const int32 MovementCost = AddCost(CurrentCost, Weight);
+
+				// if Neighbour is not cheaper this Way return. Equal Costs keep the first Parent,
+				// so Paths do not flip between equally long Alternatives
+				if (MovementCost >= State.GCost[NeighbourID])
+				{
+					return;
+				}
+
+				// Set Current Node Parent
+				State.ParentID[NeighbourID] = CurrentID;
+
+				// Set New Movement Cost, the Heuristic of a Node never changes during one Search
+				if (State.GCost[NeighbourID] == INITIAL_DISTANCE)
+				{
+					State.HCost[NeighbourID] = Heuristic(Graph, NeighbourID, TargetID);
+				}
+				State.GCost[NeighbourID] = MovementCost;
+
+				if (OpenSet.Push(NeighbourID))
+				{
+					BYTES_SEARCH_STAT(Stats->HeapUpdates++);
+				}
+				else
+				{
+					BYTES_SEARCH_STAT(Stats->HeapPushes++);
+					BYTES_SEARCH_STAT(Stats->PeakOpenSetSize = FMath::Max<int64>(Stats->PeakOpenSetSize, OpenSet.Num()));
+				}
+			});
+		}
+	}
+
+	/*
+	 * A* from StartID to TargetID. Writes Costs and Parents into State.
+	 * Returns true if the Target has been reached. Stats is optional.
+	 */
+	template<typename QueueType = FBytesIndexedQueue, typename HeuristicType = FBytesEuclideanHeuristic, typename GraphType, typename StateType>
+	bool AStar(const GraphType& Graph, StateType& State, const int32 StartID, const int32 TargetID, FBytesSearchStats* Stats = nullptr)
+	{
+		return BestFirstSearch<HeuristicType, QueueType>(Graph, State, StartID, TargetID, Stats);
+	}
+
+	/*
+	 * Weighted A*, see "TBytesInflatedHeuristic". Closed Nodes are never reopened, the Bound still holds.
+	 * Writes Costs and Parents into State. Returns true if the Target has been reached. Stats is optional.
+	 */
+	template<typename QueueType = FBytesIndexedQueue, typename HeuristicType = FBytesEuclideanHeuristic, typename GraphType, typename StateType>
+	bool WeightedAStar(const GraphType& Graph, StateType& State, const int32 StartID, const int32 TargetID, const double Weight, FBytesSearchStats* Stats = nullptr)
+	{
+		using FInflatedHeuristic = TBytesInflatedHeuristic<HeuristicType>;
+		return BestFirstSearch<FInflatedHeuristic, QueueType>(Graph, State, StartID, TargetID, Stats, FInflatedHeuristic(Weight));
+	}
+
+	// Dijkstra from StartID to every reachable Node. Writes Costs and Parents into State. Stats is optional.
+	template<typename QueueType = FBytesIndexedQueue, typename GraphType>
+	void Dijkstra(const GraphType& Graph, FBytesSearchState& State, const int32 StartID, FBytesSearchStats* Stats = nullptr)
+	{
+		BestFirstSearch<FBytesZeroHeuristic, QueueType>(Graph, State, StartID, INDEX_NONE, Stats);
+	}
+
+	/*
+	 * Theta*, see http://idm-lab.org/bib/abstracts/papers/jair10b.pdf: A* where every Neighbour may also take the Parent
+	 * of the expanded Node as its own, if the Line of Sight Policy connects them for less. Paths follow straight Lines
+	 * between Corners instead of the Edges, consecutive Path Nodes are often far apart.
+	 * Not always the cheapest Path, but never worse than the Edges it replaces.
+	 * Writes Costs and Parents into State. Returns true if the Target has been reached. Stats is optional.
+	 */
+	template<typename LineOfSightType, typename QueueType = FBytesIndexedQueue, typename HeuristicType = FBytesEuclideanHeuristic, typename GraphType>
+	bool ThetaStar(const GraphType& Graph, FBytesSearchState& State, const int32 StartID, const int32 TargetID, FBytesSearchStats* Stats = nullptr, const LineOfSightType& LineOfSight = LineOfSightType(), const HeuristicType& Heuristic = HeuristicType())
+	{
+		BYTES_SEARCH_STAT_TIMER();
+
+		const int32 NumNodes = Graph.NumNodes();
+		State.Init(NumNodes, INITIAL_DISTANCE);
+
+		QueueType OpenSet(State, NumNodes);
+		TBitArray<> ClosedSet(false, NumNodes);
+
+		State.GCost[StartID] = 0;
+		State.HCost[StartID] = Heuristic(Graph, StartID, TargetID);
+		OpenSet.Push(StartID);
+		BYTES_SEARCH_STAT(Stats->HeapPushes++);
+		BYTES_SEARCH_STAT(Stats->PeakOpenSetSize = FMath::Max<int64>(Stats->PeakOpenSetSize, 1));
+
+		while (true)
+		{
+			const int32 CurrentID = OpenSet.Pop();
+			if (CurrentID == INDEX_NONE)
+			{
+				return false;
+			}
+
+			ClosedSet[CurrentID] = true;
+			BYTES_SEARCH_STAT(Stats->HeapPops++);
+			BYTES_SEARCH_STAT(Stats->NodesExpanded++);
+
+			if (CurrentID == TargetID)
+			{
+				return true;
+			}
+
+			const int32 CurrentCost = State.GCost[CurrentID];
+			const int32 GrandParentID = State.ParentID[CurrentID];
+
+			Graph.ForEachNeighbour(CurrentID, [&](const int32 NeighbourID, const int32 Weight)
+			{
+				BYTES_SEARCH_STAT(Stats->NodesGenerated++);
+
+				if (ClosedSet[NeighbourID])
+				{
+					return;
+				}
+
+				int32 MovementCost = AddCost(CurrentCost, Weight);
+				int32 NewParentID = CurrentID;
+
+				// Straight from the Grand Parent. The Euclidean Distance skips Lines that can not be cheaper without testing them
+				if (GrandParentID != INDEX_NONE)
+				{
+					const int32 GrandParentCost = State.GCost[GrandParentID];
+					const int32 BestCost = FMath::Min(MovementCost, State.GCost[NeighbourID]);
+					int32 LineCost;
+					if (AddCost(GrandParentCost, HeuristicDistance(Graph, GrandParentID, NeighbourID)) < BestCost)
+					{
+						BYTES_SEARCH_STAT(Stats->LineOfSightChecks++);
+						if (LineOfSight(Graph, GrandParentID, NeighbourID, LineCost) && AddCost(GrandParentCost, LineCost) <= MovementCost)
+						{
+							MovementCost = AddCost(GrandParentCost, LineCost);
+							NewParentID = GrandParentID;
+						}
+					}
+				}
+
+				if (MovementCost >= State.GCost[NeighbourID])
+				{
+					return;
+				}
+
+				State.ParentID[NeighbourID] = NewParentID;
+				if (State.GCost[NeighbourID] == INITIAL_DISTANCE)
+				{
+					State.HCost[NeighbourID] = Heuristic(Graph, NeighbourID, TargetID);
+				}
+				State.GCost[NeighbourID] = MovementCost;
+
+				if (OpenSet.Push(NeighbourID))
+				{
+					BYTES_SEARCH_STAT(Stats->HeapUpdates++);
+				}
+				else
+				{
+					BYTES_SEARCH_STAT(Stats->HeapPushes++);
+					BYTES_SEARCH_STAT(Stats->PeakOpenSetSize = FMath::Max<int64>(Stats->PeakOpenSetSize, OpenSet.Num()));
+				}
+			});
+		}
+	}
+
+	/*
+	 * Lazy Theta*, see http://idm-lab.org/bib/abstracts/papers/aaai10b.pdf: assumes every Neighbour sees the Parent
+	 * of the expanded Node and queues it with the Euclidean Cost. The Line only gets tested once the Neighbour is expanded,
+	 * most queued Nodes never are. Without Sight, or if the Line costs more, the Node takes its cheapest closed Neighbour as Parent.
+	 * Needs "ForEachIncomingNeighbour()". Same Results as "ThetaStar()" in most Cases, with a Fraction of the Line of Sight Checks.
+	 */
+	template<typename LineOfSightType, typename QueueType = FBytesIndexedQueue, typename HeuristicType = FBytesEuclideanHeuristic, typename GraphType>
+	bool LazyThetaStar(const GraphType& Graph, FBytesSearchState& State, const int32 StartID, const int32 TargetID, FBytesSearchStats* Stats = nullptr, const LineOfSightType& LineOfSight = LineOfSightType(), const HeuristicType& Heuristic = HeuristicType())
+	{
+		BYTES_SEARCH_STAT_TIMER();
+
+		const int32 NumNodes = Graph.NumNodes();
+		State.Init(NumNodes, INITIAL_DISTANCE);
+
+		QueueType OpenSet(State, NumNodes);
+		TBitArray<> ClosedSet(false, NumNodes);
+
+		// Nodes whose Parent was only assumed to see them
+		TBitArray<> UncheckedSet(false, NumNodes);
+
+		State.GCost[StartID] = 0;
+		State.HCost[StartID] = Heuristic(Graph, StartID, TargetID);
+		OpenSet.Push(StartID);
+		BYTES_SEARCH_STAT(Stats->HeapPushes++);
+		BYTES_SEARCH_STAT(Stats->PeakOpenSetSize = FMath::Max<int64>(Stats->PeakOpenSetSize, 1));
+
+		while (true)
+		{
+			const int32 CurrentID = OpenSet.Pop();
+			if (CurrentID == INDEX_NONE)
+			{
+				return false;
+			}
+
+			// Checked Costs may match an older Entry of the Lazy Queue again
+			if (ClosedSet[CurrentID])
+			{
+				continue;
+			}
+
+			ClosedSet[CurrentID] = true;
+			BYTES_SEARCH_STAT(Stats->HeapPops++);
+			BYTES_SEARCH_STAT(Stats->NodesExpanded++);
+
+			// Check the assumed Line, closed Neighbours have their final Costs. The Node that queued this one is always among them
+			if (UncheckedSet[CurrentID])
+			{
+				UncheckedSet[CurrentID] = false;
+				BYTES_SEARCH_STAT(Stats->LineOfSightChecks++);
+
+				const int32 AssumedParentID = State.ParentID[CurrentID];
+				int32 LineCost;
+				int32 BestCost = LineOfSight(Graph, AssumedParentID, CurrentID, LineCost) ? AddCost(State.GCost[AssumedParentID], LineCost) : INITIAL_DISTANCE;
+				int32 BestParentID = AssumedParentID;
+
+				if (BestCost > State.GCost[CurrentID])
+				{
+					Graph.ForEachIncomingNeighbour(CurrentID, [&](const int32 SourceID, const int32 Weight)
+					{
+						const int32 Cost = ClosedSet[SourceID] && SourceID != CurrentID ? AddCost(State.GCost[SourceID], Weight) : INITIAL_DISTANCE;
+						if (Cost < BestCost)
+						{
+							BestCost = Cost;
+							BestParentID = SourceID;
+						}
+					});
+				}
+
+				State.GCost[CurrentID] = BestCost;
+				State.ParentID[CurrentID] = BestParentID;
+			}
+
+			if (CurrentID == TargetID)
+			{
+				return true;
+			}
+
+			const int32 CurrentCost = State.GCost[CurrentID];
+			const int32 GrandParentID = State.ParentID[CurrentID];
+
+			Graph.ForEachNeighbour(CurrentID, [&](const int32 NeighbourID, const int32 Weight)
+			{
+				BYTES_SEARCH_STAT(Stats->NodesGenerated++);
+
+				if (ClosedSet[NeighbourID])
+				{
+					return;
+				}
+
+				// The Euclidean Distance is the Cost of the Line if there is one, or at least never more
+				int32 MovementCost = AddCost(CurrentCost, Weight);
+				int32 NewParentID = CurrentID;
+				if (GrandParentID != INDEX_NONE)
+				{
+					const int32 AssumedCost = AddCost(State.GCost[GrandParentID], HeuristicDistance(Graph, GrandParentID, NeighbourID));
+					if (AssumedCost < MovementCost)
+					{
+						MovementCost = AssumedCost;
+						NewParentID = GrandParentID;
+					}
+				}
+
+				if (MovementCost >= State.GCost[NeighbourID])
+				{
+					return;
+				}
+
+				State.ParentID[NeighbourID] = NewParentID;
+				UncheckedSet[NeighbourID] = NewParentID != CurrentID;
+				if (State.GCost[NeighbourID] == INITIAL_DISTANCE)
+				{
+					State.HCost[NeighbourID] = Heuristic(Graph, NeighbourID, TargetID);
+				}
+				State.GCost[NeighbourID] = MovementCost;
+
+				if (OpenSet.Push(NeighbourID))
+				{
+					BYTES_SEARCH_STAT(Stats->HeapUpdates++);
+				}
+				else
+				{
+					BYTES_SEARCH_STAT(Stats->HeapPushes++);
+					BYTES_SEARCH_STAT(Stats->PeakOpenSetSize = FMath::Max<int64>(Stats->PeakOpenSetSize, OpenSet.Num()));
+				}
+			});
+		}
+	}
+
+	// Walks the Parents from Target back to Start. Returns an empty Array if the Target has never been reached
+	inline TArray<int32> RetracePath(const TArray<int32>& ParentIDs, const int32 StartID, const int32 TargetID)
+	{
+		TArray<int32> Path;
+
+		if (!ParentIDs.IsValidIndex(StartID) || !ParentIDs.IsValidIndex(TargetID) || (TargetID != StartID && ParentIDs[TargetID] == INDEX_NONE))
+		{
+			return Path;
+		}
+
+		// Iterate over each parent of current node until we reached Start Node
+		// We Iterate from Target -> Start
+		int32 CurrentNodeID = TargetID;
+		while (CurrentNodeID != StartID && CurrentNodeID != INDEX_NONE)
+		{
+			Path.Add(CurrentNodeID);
+			CurrentNodeID = ParentIDs[CurrentNodeID];
+		}
+
+		// The Parents belong to a Search from another Start
+		if (CurrentNodeID != StartID)
+		{
+			Path.Reset();
+			return Path;
+		}
+
+		Algo::Reverse(Path);
+		return Path;
+	}
+
+	inline TArray<int32> RetracePath(const FBytesSearchState& State, const int32 StartID, const int32 TargetID)
+	{
+		return RetracePath(State.ParentID, StartID, TargetID);
+	}
+
+	// Same for the sparse State, unreached Nodes have no Parent
+	inline TArray<int32> RetracePath(const FBytesSparseSearchState& State, const int32 StartID, const int32 TargetID)
+	{
+		TArray<int32> Path;
+		if (TargetID != StartID && State.ParentID[TargetID] == INDEX_NONE)
+		{
+			return Path;
+		}
+
+		int32 CurrentNodeID = TargetID;
+		while (CurrentNodeID != StartID && CurrentNodeID != INDEX_NONE && Path.Num() <= State.NumReached())
+		{
+			Path.Add(CurrentNodeID);
+			CurrentNodeID = State.ParentID[CurrentNodeID];
+		}
+
+		if (CurrentNodeID != StartID)
+		{
+			Path.Reset();
+			return Path;
+		}
+
+		Algo::Reverse(Path);
+		return Path;
+	}
+
+	// Walks the Parents of a backwards Search from Start to its Target. Returns an empty Array if Start can not reach the Target
+	inline TArray<int32> FollowPath(const FBytesSearchState& State, const int32 StartID, const int32 TargetID)
+	{
+		TArray<int32> Path;
+
+		const TArray<int32>& ParentIDs = State.ParentID;
+		if (!ParentIDs.IsValidIndex(StartID) || !ParentIDs.IsValidIndex(TargetID))
+		{
+			return Path;
+		}
+
+		// Parents point towards the Target, so the Path comes out in the right Order
+		int32 CurrentNodeID = StartID;
+		while (CurrentNodeID != TargetID && Path.Num() < ParentIDs.Num())
+		{
+			CurrentNodeID = ParentIDs[CurrentNodeID];
+			if (CurrentNodeID == INDEX_NONE)
+			{
+				Path.Reset();
+				return Path;
+			}
+			Path.Add(CurrentNodeID);
+		}
+
+		// The Parents run in a Cycle and never reach the Target
+		if (CurrentNodeID != TargetID)
+		{
+			Path.Reset();
+		}
+
+		return Path;
+	}
+}
+
+// ==== Section | Anytime Search ==== //
+
+/*
+ * ARA*, see https://papers.nips.cc/paper/2382-ara-anytime-a-with-provable-bounds-on-sub-optimality:
+ * a Series of Weighted A* Searches with falling Weights. The first Iteration returns a Path quickly,
+ * every further one improves it until the Weight reaches 1 and the Path is the cheapest.
+ * Iterations reuse the Costs of the previous ones and only reopen Nodes that got cheaper, so most Work is done once.
+ *
+ * Writes Costs and Parents into State, after every Iteration "BytesSearch::RetracePath()" returns the current Path.
+ * Keeps its own Open List, it has to be rebuilt whenever the Weight changes. State and Graph must outlive the Search.
+ */
+template<typename GraphType, typename HeuristicType = FBytesEuclideanHeuristic>
+class TBytesAnytimeAStar
+{
+public:
+	TBytesAnytimeAStar(const GraphType& InGraph, FBytesSearchState& InState, const int32 InStartID, const int32 InTargetID, const double InitialWeight, const double InWeightStep = 0.5)
+		: Graph(InGraph)
+		, State(InState)
+		, StartID(InStartID)
+		, TargetID(InTargetID)
+		, Weight(FMath::Max(InitialWeight, 1.0))
+		, WeightStep(FMath::Max(InWeightStep, 0.01))
+		, Bound(Weight)
+	{
+		const int32 NumNodes = Graph.NumNodes();
+		State.Init(NumNodes, INITIAL_DISTANCE);
+		Estimates.Init(INDEX_NONE, NumNodes);
+		ClosedSet.Init(false, NumNodes);
+		OpenSet.Init(false, NumNodes);
+		InconsistentSet.Init(false, NumNodes);
+
+		State.GCost[StartID] = 0;
+		Open(StartID);
+	}
+
+	/*
+	 * Runs the next Iteration, the first one with the initial Weight and every further one with WeightStep less.
+	 * Returns true if there is a Path. Does nothing once the Path is the cheapest. Stats is optional.
+	 */
+	bool Improve(FBytesSearchStats* Stats = nullptr)
+	{
+		if (IsOptimal())
+		{
+			return HasPath();
+		}
+
+		BYTES_SEARCH_STAT_TIMER();
+
+		// Every Iteration but the first lowers the Weight, reopens the Nodes that got cheaper and starts with an empty Closed List
+		if (NumIterations > 0)
+		{
+			Weight = FMath::Max(Weight - WeightStep, 1.0);
+			for (const int32 NodeID : InconsistentNodes)
+			{
+				InconsistentSet[NodeID] = false;
+				if (!OpenSet[NodeID])
+				{
+					OpenSet[NodeID] = true;
+					OpenNodes.Add(NodeID);
+				}
+			}
+			InconsistentNodes.Reset();
+			ClosedSet.Init(false, Graph.NumNodes());
+			RebuildOpenList();
+		}
+		NumIterations++;
+
+		ImprovePath(Stats);
+		UpdateBound();
+		return HasPath();
+	}
+
+	/*
+	 * Improves the Path until it is the cheapest or MaxSeconds have passed. Always finishes the first Iteration,
+	 * so there is a Path whenever the Target can be reached. Returns true if there is a Path.
+	 */
+	bool Run(const double MaxSeconds, FBytesSearchStats* Stats = nullptr)
+	{
+		const double EndTime = FPlatformTime::Seconds() + MaxSeconds;
+		do
+		{
+			Improve(Stats);
+		}
+		while (!IsOptimal() && FPlatformTime::Seconds() < EndTime);
+		return HasPath();
+	}
+
+	bool HasPath() const
+	{
+		return State.GCost[TargetID] != INITIAL_DISTANCE;
+	}
+
+	// The current Path costs at most this Factor times the cheapest Path. 1 once it is the cheapest
+	double GetSuboptimalityBound() const
+	{
+		return Bound;
+	}
+
+	// Also true if all Iterations ran and the Target can not be reached
+	bool IsOptimal() const
+	{
+		return NumIterations > 0 && (Bound <= 1.0 || Weight <= 1.0);
+	}
+
+	double GetWeight() const
+	{
+		return Weight;
+	}
+
+	int32 GetNumIterations() const
+	{
+		return NumIterations;
+	}
+
+private:
+	struct FEntry
+	{
+		int64 FCost;
+		int32 GCost;
+		int32 NodeID;
+
+		static bool HasHigherPriority(const FEntry& A, const FEntry& B)
+		{
+			return A.FCost < B.FCost;
+		}
+	};
+
+	const GraphType& Graph;
+	FBytesSearchState& State;
+	int32 StartID;
+	int32 TargetID;
+	double Weight;
+	double WeightStep;
+	double Bound;
+	int32 NumIterations = 0;
+	HeuristicType Heuristic;
+
+	// Uninflated Heuristic per Node, -1 until first needed
+	TArray<int32> Estimates;
+
+	// Lazy Heap, Entries are stale once the GCost of their Node changed or it got closed
+	TArray<FEntry> Entries;
+
+	// Closed in the current Iteration. Nodes that get cheaper after that wait in the Inconsistent List for the next one
+	TBitArray<> ClosedSet;
+	TBitArray<> OpenSet;
+	TBitArray<> InconsistentSet;
+	TArray<int32> OpenNodes;
+	TArray<int32> InconsistentNodes;
+
+	int32 GetEstimate(const int32 NodeID)
+	{
+		if (Estimates[NodeID] == INDEX_NONE)
+		{
+			Estimates[NodeID] = Heuristic(Graph, NodeID, TargetID);
+		}
+		return Estimates[NodeID];
+	}
+
+	void Open(const int32 NodeID)
+	{
+		State.HCost[NodeID] = TBytesInflatedHeuristic<HeuristicType>(Weight).Inflate(GetEstimate(NodeID));
+		Entries.HeapPush({State.FCost(NodeID), State.GCost[NodeID], NodeID}, FEntry::HasHigherPriority);
+		if (!OpenSet[NodeID])
+		{
+			OpenSet[NodeID] = true;
+			OpenNodes.Add(NodeID);
+		}
+	}
+
+	// New Weight, new Keys for every open Node
+	void RebuildOpenList()
+	{
+		Entries.Reset();
+		int32 NumOpen = 0;
+		for (const int32 NodeID : OpenNodes)
+		{
+			if (!OpenSet[NodeID])
+			{
+				continue;
+			}
+
+			State.HCost[NodeID] = TBytesInflatedHeuristic<HeuristicType>(Weight).Inflate(GetEstimate(NodeID));
+			Entries.Add({State.FCost(NodeID), State.GCost[NodeID], NodeID});
+			OpenNodes[NumOpen++] = NodeID;
+		}
+		OpenNodes.SetNum(NumOpen);
+		Entries.Heapify(FEntry::HasHigherPriority);
+	}
+
+	void ImprovePath(FBytesSearchStats* Stats)
+	{
+		while (!Entries.IsEmpty())
+		{
+			// Stops once no open Node could lead to a cheaper Path under the current Weight
+			const FEntry& Top = Entries.HeapTop();
+			const bool bStale = Top.GCost != State.GCost[Top.NodeID] || !OpenSet[Top.NodeID];
+			if (!bStale && Top.FCost >= State.GCost[TargetID])
+			{
+				return;
+			}
+
+			FEntry Entry;
+			Entries.HeapPop(Entry, FEntry::HasHigherPriority);
+			if (bStale)
+			{
+				continue;
+			}
+
+			const int32 CurrentID = Entry.NodeID;
+			OpenSet[CurrentID] = false;
+			ClosedSet[CurrentID] = true;
+			BYTES_SEARCH_STAT(Stats->HeapPops++);
+			BYTES_SEARCH_STAT(Stats->NodesExpanded++);
+
+			const int32 CurrentCost = State.GCost[CurrentID];
+			Graph.ForEachNeighbour(CurrentID, [&](const int32 NeighbourID, const int32 NeighbourWeight)
+			{
+				BYTES_SEARCH_STAT(Stats->NodesGenerated++);
+
+				const int32 MovementCost = BytesSearch::AddCost(CurrentCost, NeighbourWeight);
+				if (MovementCost >= State.GCost[NeighbourID])
+				{
+					return;
+				}
+
+				State.GCost[NeighbourID] = MovementCost;
+				State.ParentID[NeighbourID] = CurrentID;
+
+				// Closed Nodes are not reopened within one Iteration
+				if (ClosedSet[NeighbourID])
+				{
+					if (!InconsistentSet[NeighbourID])
+					{
+						InconsistentSet[NeighbourID] = true;
+						InconsistentNodes.Add(NeighbourID);
+					}
+					return;
+				}
+
+				Open(NeighbourID);
+				BYTES_SEARCH_STAT(Stats->HeapPushes++);
+				BYTES_SEARCH_STAT(Stats->PeakOpenSetSize = FMath::Max<int64>(Stats->PeakOpenSetSize, Entries.Num()));
+			});
+		}
+	}
+
+	// Cost of the Path over the lowest uninflated FCost any Node still waiting could lead to
+	void UpdateBound()
+	{
+		// Without a Path only an exhausted Search is final
+		if (!HasPath())
+		{
+			Bound = Entries.IsEmpty() && InconsistentNodes.IsEmpty() ? 1.0 : Weight;
+			return;
+		}
+
+		int64 LowestCost = State.GCost[TargetID];
+		for (const TArray<int32>* Nodes : {&OpenNodes, &InconsistentNodes})
+		{
+			for (const int32 NodeID : *Nodes)
+			{
+				if (OpenSet[NodeID] || InconsistentSet[NodeID])
+				{
+					LowestCost = FMath::Min<int64>(LowestCost, int64(State.GCost[NodeID]) + GetEstimate(NodeID));
+				}
+			}
+		}
+		Bound = LowestCost > 0 ? FMath::Min(Weight, double(State.GCost[TargetID]) / LowestCost) : 1.0;
+	}
+};
+
+// ==== Section | Memory Bounded Search ==== //
+
+/*
+ * Fringe Search, see https://webdocs.cs.ualberta.ca/~holte/Publications/fringe.pdf:
+ * IDA* that keeps the Fringe of the last Iteration instead of starting over from the Start Node.
+ * Each Iteration expands every Node up to the Threshold. Nodes beyond it wait for the next Iteration, which uses the lowest FCost seen beyond it.
+ * With an admissible Heuristic the first Path found is the cheapest.
+ *
+ * There is no Array per Node of the Graph. Costs and Parents live in a Hash Table for the reached Nodes only,
+ * so Memory grows with the searched Area and not with the Map. Works on every Graph Accessor,
+ * also on procedural ones that compute Neighbours and Costs on the Fly.
+ */
+struct FBytesFringeNode
+{
+	int32 GCost = INITIAL_DISTANCE;
+	int32 HCost = 0;
+	int32 ParentID = INDEX_NONE;
+
+	// Bumped whenever the Node goes onto the Fringe again, older Fringe Entries are stale
+	uint32 Version = 0;
+};
+
+namespace BytesSearch
+{
+	/*
+	 * Writes the Path from StartID to TargetID into OutPath, without StartID like "RetracePath()".
+	 * Gives up once more than MaxCachedNodes Nodes have been reached, 0 for no Limit. Returns true if a Path has been found.
+	 * Stats is optional, its Peak Open Set Size counts the Fringe Entries.
+	 */
+	template<typename HeuristicType = FBytesEuclideanHeuristic, typename GraphType>
+	bool FringeSearch(const GraphType& Graph, const int32 StartID, const int32 TargetID, TArray<int32>& OutPath, FBytesSearchStats* Stats = nullptr, const int32 MaxCachedNodes = 0, const HeuristicType& Heuristic = HeuristicType())
+	{
+		BYTES_SEARCH_STAT_TIMER();
+
+		struct FEntry
+		{
+			int32 NodeID;
+			uint32 Version;
+		};
+
+		OutPath.Reset();
+		if (StartID < 0 || StartID >= Graph.NumNodes() || TargetID < 0 || TargetID >= Graph.NumNodes())
+		{
+			return false;
+		}
+
+		TMap<int32, FBytesFringeNode> Cache;
+		FBytesFringeNode& Start = Cache.Add(StartID);
+		Start.GCost = 0;
+		Start.HCost = Heuristic(Graph, StartID, TargetID);
+
+		// Now is worked off as a Stack, so Children are searched right after their Parent like in IDA*
+		TArray<FEntry> Now;
+		TArray<FEntry> Later;
+		Now.Add({StartID, 0});
+		int64 Threshold = Start.HCost;
+
+		while (!Now.IsEmpty())
+		{
+			int64 NextThreshold = MAX_int64;
+			while (!Now.IsEmpty())
+			{
+				const FEntry Entry = Now.Pop();
+				const FBytesFringeNode Current = Cache.FindChecked(Entry.NodeID);
+				if (Entry.Version != Current.Version)
+				{
+					continue;
+				}
+
+				const int64 FCost = int64(Current.GCost) + Current.HCost;
+				if (FCost > Threshold)
+				{
+					NextThreshold = FMath::Min(NextThreshold, FCost);
+					Later.Add(Entry);
+					continue;
+				}
+
+				if (Entry.NodeID == TargetID)
+				{
+					for (int32 NodeID = TargetID; NodeID != StartID; NodeID = Cache.FindChecked(NodeID).ParentID)
+					{
+						OutPath.Add(NodeID);
+					}
+					Algo::Reverse(OutPath);
+					return true;
+				}
+
+				BYTES_SEARCH_STAT(Stats->NodesExpanded++);
+
+				bool bCacheFull = false;
+				Graph.ForEachNeighbour(Entry.NodeID, [&](const int32 NeighbourID, const int32 NeighbourWeight)
+				{
+					BYTES_SEARCH_STAT(Stats->NodesGenerated++);
+
+					const int32 MovementCost = AddCost(Current.GCost, NeighbourWeight);
+					FBytesFringeNode* Neighbour = Cache.Find(NeighbourID);
+					if (Neighbour == nullptr)
+					{
+						if (MovementCost == INITIAL_DISTANCE || (MaxCachedNodes > 0 && Cache.Num() >= MaxCachedNodes))
+						{
+							bCacheFull |= MovementCost != INITIAL_DISTANCE;
+							return;
+						}
+						Neighbour = &Cache.Add(NeighbourID);
+						Neighbour->HCost = Heuristic(Graph, NeighbourID, TargetID);
+					}
+					else if (MovementCost >= Neighbour->GCost)
+					{
+						return;
+					}
+
+					// Cheaper than before, goes onto the Fringe right after its Parent. Its older Entry is stale now
+					Neighbour->GCost = MovementCost;
+					Neighbour->ParentID = Entry.NodeID;
+					Neighbour->Version++;
+					Now.Add({NeighbourID, Neighbour->Version});
+					BYTES_SEARCH_STAT(Stats->HeapPushes++);
+				});
+				BYTES_SEARCH_STAT(Stats->PeakOpenSetSize = FMath::Max<int64>(Stats->PeakOpenSetSize, Now.Num() + Later.Num()));
+
+				if (bCacheFull)
+				{
+					return false;
+				}
+			}
+
+			Threshold = NextThreshold;
+			Swap(Now, Later);
+		}
+
+		return false;
+	}
+}
+
+// ==== Section | Path Simplification ==== //
+
+namespace BytesSearch
+{
+	/*
+	 * Cost of one Step of a Path: the cheapest Edge From -> To, otherwise the straight Line if the Policy connects them.
+	 * INITIAL_DISTANCE if neither exists.
+	 */
+	template<typename LineOfSightType, typename GraphType>
+	int32 GetStepCost(const GraphType& Graph, const LineOfSightType& LineOfSight, const int32 FromID, const int32 ToID)
+	{
+		int32 Cost = INITIAL_DISTANCE;
+		Graph.ForEachNeighbour(FromID, [&Cost, ToID](const int32 NeighbourID, const int32 Weight)
+		{
+			if (NeighbourID == ToID)
+			{
+				Cost = FMath::Min(Cost, Weight);
+			}
+		});
+
+		int32 LineCost;
+		if (Cost == INITIAL_DISTANCE && LineOfSight(Graph, FromID, ToID, LineCost))
+		{
+			Cost = LineCost;
+		}
+		return Cost;
+	}
+
+	// Summed Step Costs of a Path in the "GetPath()" Format, Start excluded
+	template<typename LineOfSightType, typename GraphType>
+	int64 GetPathCost(const GraphType& Graph, const LineOfSightType& LineOfSight, const int32 StartID, const TArray<int32>& Path)
+	{
+		int64 Cost = 0;
+		int32 PreviousID = StartID;
+		for (const int32 NodeID : Path)
+		{
+			Cost += GetStepCost(Graph, LineOfSight, PreviousID, NodeID);
+			PreviousID = NodeID;
+		}
+		return Cost;
+	}
+
+	/*
+	 * Drops every Node that lies on the straight Line between the Nodes before and after it,
+	 * e.g. all but the Ends of a straight Run through a Grid. Lossless, the Path still walks the same Lines.
+	 * Path is in the "GetPath()" Format, Start excluded. Runs in place.
+	 */
+	template<typename GraphType>
+	void RemoveCollinearNodes(const GraphType& Graph, const int32 StartID, TArray<int32>& Path)
+	{
+		if (Path.Num() < 2)
+		{
+			return;
+		}
+
+		// Kept Nodes get moved to the Front, the last kept Node is the Anchor of the current Run
+		FVector2D Previous = Graph.GetLocation(StartID);
+		int32 NumKept = 0;
+		for (int32 Index = 0; Index + 1 < Path.Num(); Index++)
+		{
+			const FVector2D Current = Graph.GetLocation(Path[Index]);
+			const FVector2D Next = Graph.GetLocation(Path[Index + 1]);
+			const FVector2D In = Current - Previous;
+			const FVector2D Out = Next - Current;
+
+			// Relative Tolerance, Hex Locations are not exact
+			const bool bCollinear = FVector2D::DotProduct(In, Out) > 0.0 && FMath::Abs(FVector2D::CrossProduct(In, Out)) <= 1e-9 * In.Size() * Out.Size();
+			if (!bCollinear)
+			{
+				Path[NumKept++] = Path[Index];
+				Previous = Current;
+			}
+		}
+
+		Path[NumKept++] = Path.Last();
+		Path.SetNum(NumKept);
+	}
+
+	/*
+	 * String Pulling: walks the Path and skips every Node the last kept Node can see past, if the straight Line
+	 * costs no more than the skipped Steps. Grid Corridors turn into a few Lines between Corners, like the Funnel Algorithm
+	 * gives on Navigation Meshes. Takes one Line of Sight Check per Node of the Path.
+	 * Path is in the "GetPath()" Format, Start excluded. Runs in place, never makes the Path more expensive.
+	 */
+	template<typename LineOfSightType, typename GraphType>
+	void PullString(const GraphType& Graph, const LineOfSightType& LineOfSight, const int32 StartID, TArray<int32>& Path)
+	{
+		if (Path.Num() < 2)
+		{
+			return;
+		}
+
+		int32 AnchorID = StartID;
+		int32 PreviousID = StartID;
+
+		// Cost of the Steps since the Anchor, on the original Path
+		int64 StepsCost = 0;
+		int32 NumKept = 0;
+		for (int32 Index = 0; Index < Path.Num(); Index++)
+		{
+			const int32 NodeID = Path[Index];
+			const int64 CostToNode = StepsCost + GetStepCost(Graph, LineOfSight, PreviousID, NodeID);
+
+			// The Line has to reach this Node, otherwise the Node before it becomes a Corner
+			int32 LineCost;
+			if (PreviousID != AnchorID && !(LineOfSight(Graph, AnchorID, NodeID, LineCost) && LineCost <= CostToNode))
+			{
+				Path[NumKept++] = PreviousID;
+				AnchorID = PreviousID;
+				StepsCost = GetStepCost(Graph, LineOfSight, PreviousID, NodeID);
+			}
+			else
+			{
+				StepsCost = CostToNode;
+			}
+			PreviousID = NodeID;
+		}
+
+		Path[NumKept++] = Path.Last();
+		Path.SetNum(NumKept);
+	}
+}
@@ -0,0 +1,97 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#include "Pathfinding/BytesPathfinderTrace.h"
+#include "HAL/PlatformTLS.h"
+#include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	struct FBytesTraceEvent
+	{
+		const TCHAR* Name;
+		uint64 Cycles;
+		uint32 ThreadID;
+		int32 StartID;
+		int32 TargetID;
+		char Phase;
+	};
+
+	// Searches may run on several Threads at once
+	FCriticalSection TraceLock;
+	TArray<FBytesTraceEvent> TraceEvents;
+	int64 NumDroppedEvents = 0;
+}
+
+void BytesTrace::AddEvent(const TCHAR* Name, const char Phase, const int32 StartID, const int32 TargetID)
+{
+	// Read the Clock before waiting for the Lock, so Timestamps are not shifted by other Threads
+	const uint64 Cycles = FPlatformTime::Cycles64();
+	const uint32 ThreadID = FPlatformTLS::GetCurrentThreadId();
+
+	FScopeLock Lock(&TraceLock);
+	if (TraceEvents.Num() >= MaxEvents)
+	{
+		NumDroppedEvents++;
+		return;
+	}
+	TraceEvents.Add({Name, Cycles, ThreadID, StartID, TargetID, Phase});
+}
+
+bool BytesTrace::WriteChromeTrace(const FString& FilePath)
+{
+	TArray<FBytesTraceEvent> Events;
+	int64 NumDropped;
+	{
+		FScopeLock Lock(&TraceLock);
+		Events = MoveTemp(TraceEvents);
+		NumDropped = NumDroppedEvents;
+		TraceEvents.Reset();
+		NumDroppedEvents = 0;
+	}
+
+	if (NumDropped > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Pathfinder Trace: %lld Events dropped, the Buffer holds %d"), NumDropped, MaxEvents);
+	}
+
+	// Timestamps are Microseconds since the earliest Event. Names are Literals from the Macros, so they need no Escaping.
+	// Clocks are read before the Lock, so other Threads may have added later Events first
+	uint64 FirstCycles = Events.IsEmpty() ? 0 : Events[0].Cycles;
+	for (const FBytesTraceEvent& Event : Events)
+	{
+		FirstCycles = FMath::Min(FirstCycles, Event.Cycles);
+	}
+	const double MicrosecondsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000000.0;
+
+	FString Json = TEXT("{\"traceEvents\":[\n");
+	for (int32 Index = 0; Index < Events.Num(); Index++)
+	{
+		const FBytesTraceEvent& Event = Events[Index];
+		Json += FString::Printf(TEXT("{\"name\":\"%s\",\"cat\":\"Pathfinder\",\"ph\":\"%c\",\"ts\":%.3f,\"pid\":0,\"tid\":%u"),
+			Event.Name, TCHAR(Event.Phase), (Event.Cycles - FirstCycles) * MicrosecondsPerCycle, Event.ThreadID);
+
+		// Instant Events only span their Thread
+		if (Event.Phase == 'i')
+		{
+			Json += TEXT(",\"s\":\"t\"");
+		}
+
+		if (Event.StartID != INDEX_NONE || Event.TargetID != INDEX_NONE)
+		{
+			Json += FString::Printf(TEXT(",\"args\":{\"StartID\":%d,\"TargetID\":%d}"), Event.StartID, Event.TargetID);
+		}
+
+		Json += Index + 1 < Events.Num() ? TEXT("},\n") : TEXT("}\n");
+	}
+	Json += TEXT("]}\n");
+
+	return FFileHelper::SaveStringToFile(Json, *FilePath);
+}
+
+void BytesTrace::Reset()
+{
+	FScopeLock Lock(&TraceLock);
+	TraceEvents.Reset();
+	NumDroppedEvents = 0;
+}
@@ -0,0 +1,64 @@
+﻿// Copyright by BytesOfProcrastination all rights reserved CC 2024
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Structured Trace Events for the Pathfinder, written as Chrome Trace JSON
+ * (chrome://tracing or https://ui.perfetto.dev can open it).
+ *
+ * Tracing is off by default, define BYTES_PATHFINDER_TRACE 1 to enable it.
+ * Disabled Macros expand to nothing, so Queries pay nothing for them.
+ *
+ * BYTES_TRACE_SCOPE(Name)                        Begin Event now, End Event when the Scope ends
+ * BYTES_TRACE_SCOPE_NODES(Name, StartID, TargetID)  Same, the Begin Event carries both Node ID's
+ * BYTES_TRACE_INSTANT(Name)                      Single Event without Duration, e.g. a failed Query
+ *
+ * Names have to be String Literals, Events only store the Pointer.
+ */
+#ifndef BYTES_PATHFINDER_TRACE
+	#define BYTES_PATHFINDER_TRACE 0
+#endif
+
+#if BYTES_PATHFINDER_TRACE
+	#define BYTES_TRACE_SCOPE(Name) const FBytesTraceScope PREPROCESSOR_JOIN(BytesTraceScope, __LINE__)(TEXT(Name))
+	#define BYTES_TRACE_SCOPE_NODES(Name, StartID, TargetID) const FBytesTraceScope PREPROCESSOR_JOIN(BytesTraceScope, __LINE__)(TEXT(Name), StartID, TargetID)
+	#define BYTES_TRACE_INSTANT(Name) BytesTrace::AddEvent(TEXT(Name), 'i')
+#else
+	#define BYTES_TRACE_SCOPE(Name)
+	#define BYTES_TRACE_SCOPE_NODES(Name, StartID, TargetID)
+	#define BYTES_TRACE_INSTANT(Name)
+#endif
+
+namespace BytesTrace
+{
+	// Events beyond this are dropped, so a forgotten Trace can not eat all Memory
+	constexpr int32 MaxEvents = 1 << 20;
+
+	// Phase is the Chrome Trace Phase: 'B'egin, 'E'nd or 'i'nstant. Node ID's of -1 are not written
+	BYTESHEXGRIDPLUGIN_API void AddEvent(const TCHAR* Name, const char Phase, const int32 StartID = INDEX_NONE, const int32 TargetID = INDEX_NONE);
+
+	// Writes every recorded Event as Chrome Trace JSON and clears them. Returns false if the File could not be written
+	BYTESHEXGRIDPLUGIN_API bool WriteChromeTrace(const FString& FilePath);
+
+	BYTESHEXGRIDPLUGIN_API void Reset();
+}
+
+// Begin and End Event of one Scope, use the Macros above instead
+struct FBytesTraceScope
+{
+	explicit FBytesTraceScope(const TCHAR* InName, const int32 StartID = INDEX_NONE, const int32 TargetID = INDEX_NONE)
+		: Name(InName)
+	{
+		BytesTrace::AddEvent(Name, 'B', StartID, TargetID);
+	}
+
+	~FBytesTraceScope()
+	{
+		BytesTrace::AddEvent(Name, 'E');
+	}
+
+private:
+	const TCHAR* Name;
+};